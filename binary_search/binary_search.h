@@ -29,6 +29,7 @@
 #include <array>
 #include <iterator>
 #include "../simd_compare.h"
+#include "../neighbours.h"
 
 namespace simd_algorithms{
 namespace binary_search{
@@ -122,6 +123,31 @@ public:
         return (first!=end && !(key<*first)) ? first : ref_.end();
     }
 
+    // First value not less than key, end() when every value is less
+    const_iterator lower_bound( const value_type& key ) const
+    {
+        size_t i = greater_than_index< value_type, TAG_T >( key, cmp_ );
+        return std::lower_bound( ranges_[ i ], std::next( ranges_[ i + 1 ] ), key );
+    }
+
+    // Smallest value not less than key, end() when every value is less
+    const_iterator successor( const value_type& key ) const
+    {
+        return lower_bound( key );
+    }
+
+    // Largest value not greater than key, end() when every value is greater
+    const_iterator predecessor( const value_type& key ) const
+    {
+        return neighbours::predecessor( lower_bound( key ), ref_.begin(), ref_.end(), key );
+    }
+
+    // Closest value to key, the smaller one on ties, end() when the container is empty
+    const_iterator nearest( const value_type& key ) const
+    {
+        return neighbours::nearest( lower_bound( key ), ref_.begin(), ref_.end(), key );
+    }
+
 private:
     constexpr static size_t array_size = traits< value_type, TAG_T >::simd_size;
 
@@ -0,0 +1,121 @@
+// MIT License
+//
+// Copyright (c) 2018 André Tupinambá
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef SIMD_ALGORITHMS_BINARY_SEARCH_COMPOSITE_INDEX_H
+#define SIMD_ALGORITHMS_BINARY_SEARCH_COMPOSITE_INDEX_H
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include "../simd_compare.h"
+
+namespace simd_algorithms{
+namespace binary_search{
+
+// index_cache over (major, minor) keys kept in two columns sorted together, major first. The
+// array_size split points of each column sit in their own register and are compared with
+// composite_greater_than_mask. Positions are returned as indexes in the columns, size() when
+// there is none.
+template< class Cont_T, typename TAG_T >
+class composite_index_cache
+{
+public:
+	using container_type = Cont_T;
+    using value_type     = typename container_type::value_type;
+
+    composite_index_cache( const container_type& major, const container_type& minor )
+        : major_( major ), minor_( minor ){}
+
+    void build_index()
+    {
+        size_t step = size() / (array_size + 1);
+
+        value_type* pMajor = reinterpret_cast< value_type* >( &major_cmp_ );
+        value_type* pMinor = reinterpret_cast< value_type* >( &minor_cmp_ );
+        ranges_[ 0 ] = 0;
+        for( size_t i = 1; i <= array_size; ++i )
+        {
+            // Too few rows to split, every key goes to the first range, which is all of them
+            if( step == 0 )
+            {
+                ranges_[ i ] = size();
+                pMajor[i-1] = pMinor[i-1] = std::numeric_limits< value_type >::max();
+                continue;
+            }
+            ranges_[ i ] = i * step;
+            pMajor[i-1] = major_[ ranges_[ i ] ];
+            pMinor[i-1] = minor_[ ranges_[ i ] ];
+        }
+        ranges_[ array_size+1 ] = size();
+    }
+
+    size_t size() const
+    {
+        return major_.size();
+    }
+
+    // Position of the first row equal to (major, minor), size() when there is none
+    size_t find( value_type major, value_type minor ) const
+    {
+        size_t pos = lower_bound( major, minor );
+        return (pos < size() && major_[ pos ] == major && minor_[ pos ] == minor) ? pos : size();
+    }
+
+    // Position of the first row not less than (major, minor), size() when every row is less
+    size_t lower_bound( value_type major, value_type minor ) const
+    {
+        size_t i = mask_to_index< value_type, TAG_T >(
+                       composite_greater_than_mask< value_type, TAG_T >( major, minor, major_cmp_, minor_cmp_ ) );
+
+        // Standard lower_bound between the split points around the key
+        size_t first = ranges_[ i ];
+        size_t count = std::min( ranges_[ i + 1 ] + 1, size() ) - first;
+        while( count > 0 )
+        {
+            size_t half = count / 2;
+            size_t mid = first + half;
+            if( major_[ mid ] < major || (major_[ mid ] == major && minor_[ mid ] < minor) )
+            {
+                first = mid + 1;
+                count -= half + 1;
+            }
+            else
+            {
+                count = half;
+            }
+        }
+        return first;
+    }
+
+private:
+    constexpr static size_t array_size = traits< value_type, TAG_T >::simd_size;
+
+    const container_type& major_;
+    const container_type& minor_;
+    std::array< size_t, array_size + 2 > ranges_;
+    typename traits< value_type, TAG_T >::simd_type major_cmp_;
+    typename traits< value_type, TAG_T >::simd_type minor_cmp_;
+};
+
+}} // namespace simd_algoriths::binary_search
+
+#endif // SIMD_ALGORITHMS_BINARY_SEARCH_COMPOSITE_INDEX_H
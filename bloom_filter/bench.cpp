@@ -0,0 +1,128 @@
+// MIT License
+//
+// Copyright (c) 2018 André Tupinambá
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "bloom_filter.h"
+#include "../nway_tree/nway_tree.h"
+#include "../binary_search/binary_search.h"
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <boost/timer/timer.hpp>
+
+bool g_verbose = true;
+namespace sa = simd_algorithms;
+
+void do_nothing( int32_t );
+
+using container_type = sa::aligned_vector< int32_t >;
+
+template< class Cont_T, typename TAG_T >
+using filtered_nway = sa::filtered_index< sa::nway_tree::index< Cont_T, TAG_T >, TAG_T >;
+
+template< class Cont_T, typename TAG_T >
+using filtered_cache = sa::filtered_index< sa::binary_search::index_cache< Cont_T, TAG_T >, TAG_T >;
+
+// Nine of every ten searched keys are not in the container
+template< template < typename... > class Index_T, typename TAG_T >
+uint64_t bench( const std::string& name, const container_type& sorted, const container_type& keys, size_t loop )
+{
+    using index_type = Index_T< container_type, TAG_T >;
+
+    boost::timer::cpu_timer timer;
+    index_type index( sorted );
+    index.build_index();
+
+    timer.start();
+    for( size_t j = 0; j < loop; ++j )
+    {
+        for( auto key : keys )
+        {
+            auto ret = index.find( key );
+            do_nothing( (ret != sorted.end()) ? *ret : 0 );
+        }
+    }
+    timer.stop();
+    if( g_verbose )
+        std::cout << "Find mostly misses " << name << ": " << timer.format();
+
+    return timer.elapsed().wall;
+}
+
+int main(int argc, char* /*argv*/[])
+{
+    constexpr size_t runSize = 0x00400000;
+    constexpr size_t loop = 4;
+    if( argc > 1 )
+    {
+        g_verbose = false;
+        std::cout << "count,nway avx,filtered nway avx,cache avx,filtered cache avx" << std::endl;
+    }
+    else
+    {
+        std::cout << "\nsize: 0x" << std::hex << std::setw(8) << std::setfill( '0') << runSize << std::endl << std::endl;
+    }
+
+    // Even values are in the container, the searched keys are mostly odd
+    srand( 1 );
+    container_type sorted;
+    std::generate_n( std::back_inserter( sorted ), runSize, [](){ return rand() & ~1; } );
+    std::sort( sorted.begin(), sorted.end() );
+    container_type keys;
+    for( size_t i = 0; i < runSize; ++i )
+    {
+        keys.push_back( (i % 10) ? (rand() | 1) : sorted[ rand() % runSize ] );
+    }
+
+    size_t cnt = 0;
+    while( 1 )
+    {
+        uint64_t nway = bench< sa::nway_tree::index, sa::avx_tag >( "nway AVX .........", sorted, keys, loop );
+        uint64_t fnway = bench< filtered_nway, sa::avx_tag >( "filtered nway AVX ", sorted, keys, loop );
+        uint64_t cache = bench< sa::binary_search::index_cache, sa::avx_tag >( "cache AVX ........", sorted, keys, loop );
+        uint64_t fcache = bench< filtered_cache, sa::avx_tag >( "filtered cache AVX", sorted, keys, loop );
+
+        if( g_verbose )
+        {
+            bench< filtered_nway, sa::sse_tag >( "filtered nway SSE ", sorted, keys, loop );
+            std::cout
+                      << std::endl << "Speed up nway.......: " << std::fixed << std::setprecision(2)
+                      << static_cast<float>(nway)/static_cast<float>(fnway) << "x"
+
+                      << std::endl << "Speed up cache......: " << std::fixed << std::setprecision(2)
+                      << static_cast<float>(cache)/static_cast<float>(fcache) << "x"
+
+                      << std::endl << std::endl;
+        }
+        else
+        {
+            std::cout
+                << ++cnt << ","
+                << nway << ","
+                << fnway << ","
+                << cache << ","
+                << fcache
+                << std::endl;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,149 @@
+// MIT License
+//
+// Copyright (c) 2018 André Tupinambá
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef SIMD_ALGORITHMS_BLOOM_FILTER_H
+#define SIMD_ALGORITHMS_BLOOM_FILTER_H
+
+#include <algorithm>
+#include "../simd_compare.h"
+#include "../hash_map/hash_map.h"
+
+namespace simd_algorithms{
+
+// Register blocked Bloom filter. The high half of the key hash picks one block the size of a
+// register (128 bits on SSE, 256 on AVX) and the low half, multiplied by a different odd salt in
+// every 32 bit lane, picks one bit per lane. A key sets and tests array_size bits, all of them
+// in the same block, so a lookup touches a single cache line: one load, one multiply, one
+// shift and a testc.
+template< typename Key_T, typename TAG_T, typename Hash_T = mix_hash< Key_T > >
+class bloom_filter
+{
+public:
+    using key_type  = Key_T;
+    using simd_type = typename traits< int32_t, TAG_T >::simd_type;
+    constexpr static size_t array_size = traits< int32_t, TAG_T >::simd_size;
+
+    // About 0.4% false positives with the default 16 bits per key on SSE, 0.15% on AVX
+    bloom_filter( size_t expected_count, size_t bits_per_key = 16 )
+        : blocks_( std::max< size_t >( (expected_count * bits_per_key + block_bits - 1) / block_bits, 1 ) ),
+          bits_( blocks_ * array_size, 0 ){}
+
+    void insert( const key_type& key )
+    {
+        uint64_t hash = Hash_T()( key );
+        int32_t* block = block_ptr( hash );
+        storeu< int32_t, TAG_T >( block, mask_or< TAG_T >( loadu< int32_t, TAG_T >( block ), key_bits( hash ) ) );
+    }
+
+    // False means key was never inserted
+    bool may_contain( const key_type& key ) const
+    {
+        uint64_t hash = Hash_T()( key );
+        return all_bits_set< TAG_T >( loadu< int32_t, TAG_T >( block_ptr( hash ) ), key_bits( hash ) );
+    }
+
+    void clear()
+    {
+        std::fill( bits_.begin(), bits_.end(), 0 );
+    }
+
+    size_t block_count() const
+    {
+        return blocks_;
+    }
+
+private:
+    enum : size_t { block_bits = 32 * array_size };
+
+    size_t blocks_;
+    aligned_vector< int32_t > bits_;
+
+    const int32_t* block_ptr( uint64_t hash ) const
+    {
+        return bits_.data() + ((hash >> 32) * blocks_ >> 32) * array_size;
+    }
+
+    int32_t* block_ptr( uint64_t hash )
+    {
+        return bits_.data() + ((hash >> 32) * blocks_ >> 32) * array_size;
+    }
+
+    // The top 5 bits of each salted lane are the bit to set
+    static simd_type key_bits( uint64_t hash )
+    {
+        static const int32_t salts[ 8 ] = { 0x47b6137b, 0x44974d91, int32_t( 0x8824ad5b ), int32_t( 0xa2b7289d ),
+                                            0x705495c7, 0x2df1424b, int32_t( 0x9efc4947 ), 0x5c6bfb31 };
+        simd_type salted = multiply< int32_t, TAG_T >( broadcast< int32_t, TAG_T >( static_cast< int32_t >( hash ) ),
+                                                       loadu< int32_t, TAG_T >( salts ) );
+        return lane_bit< int32_t, TAG_T >( shift_right< int32_t, TAG_T >( salted, 27 ) );
+    }
+};
+
+// Index wrapper that asks the Bloom filter first, keys the filter rules out return end()
+// without a descent. Index_T is any index with the binary_search / nway_tree interface.
+template< class Index_T, typename TAG_T >
+class filtered_index
+{
+public:
+    using container_type = typename Index_T::container_type;
+    using value_type     = typename Index_T::value_type;
+    using const_iterator = typename Index_T::const_iterator;
+
+    filtered_index( const container_type& ref, size_t bits_per_key = 16 )
+        : ref_( ref ), index_( ref ), bits_per_key_( bits_per_key ),
+          filter_( ref.size(), bits_per_key ){}
+
+    void build_index()
+    {
+        index_.build_index();
+        filter_ = bloom_filter< value_type, TAG_T >( ref_.size(), bits_per_key_ );
+        for( auto&& key : ref_ )
+        {
+            filter_.insert( key );
+        }
+    }
+
+    const_iterator find( const value_type& key ) const
+    {
+        return filter_.may_contain( key ) ? index_.find( key ) : ref_.end();
+    }
+
+    const Index_T& index() const
+    {
+        return index_;
+    }
+
+    const bloom_filter< value_type, TAG_T >& filter() const
+    {
+        return filter_;
+    }
+
+private:
+    const container_type& ref_;
+    Index_T index_;
+    size_t bits_per_key_;
+    bloom_filter< value_type, TAG_T > filter_;
+};
+
+} // namespace simd_algorithms
+
+#endif // SIMD_ALGORITHMS_BLOOM_FILTER_H
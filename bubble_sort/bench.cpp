@@ -72,7 +72,7 @@ struct basic_bubble_sort
 };
 
 template< class Cont_T, template< typename...> class Sort_T, typename TAG_T >
-uint64_t bench( const std::string& name, size_t size, size_t loop )
+uint64_t bench( const std::string& name, size_t size, size_t loop, size_t stragglers = 0 )
 {
 	using container_type = Cont_T;
     using sort_type = Sort_T< container_type, TAG_T >;
@@ -82,6 +82,15 @@ uint64_t bench( const std::string& name, size_t size, size_t loop )
 
     srand(1);
     std::generate_n( std::back_inserter(org), size, &rand );
+    if( stragglers > 0 )
+    {
+        // Appended log: sorted keys with a few out of place
+        std::sort( std::begin( org ), std::end( org ) );
+        for( size_t i = 0; i < stragglers; ++i )
+        {
+            org[ rand() % size ] = rand();
+        }
+    }
 
     sort_type sort;
     container_type warmup( org );
@@ -106,7 +115,7 @@ uint64_t bench( const std::string& name, size_t size, size_t loop )
     }
     timer.stop();
     if( g_verbose )
-        std::cout << "Sort all " << name << ": " << timer.format();
+        std::cout << (stragglers > 0 ? "Sort nearly " : "Sort all ") << name << ": " << timer.format();
 
     return timer.elapsed().wall;
 }
@@ -145,10 +154,32 @@ int main(int argc, char* /*argv*/[])
         uint64_t avxsort2 = bench< sa::aligned_vector< int32_t >,
                                  sa::sort::bubble2,
                                  sa::avx_tag >( "AVX Bubble2 sort ", runSize, loop );
+        bench< sa::aligned_vector< int32_t >, sa::sort::nearly_sorted,
+               sa::sse_tag >( "SSE Nearly sort .", runSize, loop );
+        bench< sa::aligned_vector< int32_t >, sa::sort::nearly_sorted,
+               sa::avx_tag >( "AVX Nearly sort .", runSize, loop );
 
 
         if( g_verbose )
         {
+            constexpr size_t stragglers = runSize / 1000;
+            std::cout << std::endl;
+            uint64_t nstl = bench< sa::aligned_vector< int32_t >, stl_sort,
+                                 sa::sse_tag >( "STL sort ........", runSize, loop, stragglers );
+            bench< sa::aligned_vector< int32_t >, sa::sort::bubble2,
+                   sa::avx_tag >( "AVX Bubble2 sort ", runSize, loop, stragglers );
+            uint64_t nsse = bench< sa::aligned_vector< int32_t >, sa::sort::nearly_sorted,
+                                 sa::sse_tag >( "SSE Nearly sort .", runSize, loop, stragglers );
+            uint64_t navx = bench< sa::aligned_vector< int32_t >, sa::sort::nearly_sorted,
+                                 sa::avx_tag >( "AVX Nearly sort .", runSize, loop, stragglers );
+
+            std::cout
+                << std::endl << "SSE Nearly/STL ....: " << std::fixed << std::setprecision(2)
+                << static_cast<float>(nstl)/static_cast<float>(nsse) << "x"
+                << std::endl << "AVX Nearly/STL ....: " << std::fixed << std::setprecision(2)
+                << static_cast<float>(nstl)/static_cast<float>(navx) << "x"
+                << std::endl;
+
             std::cout
                 << std::endl << "SSE Speed up ......: " << std::fixed << std::setprecision(2)
                 << static_cast<float>(bsort)/static_cast<float>(ssesort) << "x"
@@ -30,7 +30,7 @@
 #include <iomanip>
 #include "../simd_compare.h"
 
-std::ostream& operator<<( std::ostream& out, __m128i val )
+inline std::ostream& operator<<( std::ostream& out, __m128i val )
 {
     uint32_t* pval = reinterpret_cast<uint32_t*>( &val );
     out << std::hex << "("
@@ -132,6 +132,98 @@ private:
     constexpr static size_t array_size = traits< value_type, TAG_T >::simd_size;
 };
 
+// Adaptive sort for almost sorted data. Sorted registers are kept in place with one compare,
+// the out of order elements are moved to a side buffer, sorted and merged back from the end.
+// Costs O(n + k log k) for k stragglers.
+template< class Cont_T, typename TAG_T >
+class nearly_sorted
+{
+public:
+	using container_type = Cont_T;
+    using value_type     = typename container_type::value_type;
+    using simd_type      = typename traits< value_type, TAG_T >::simd_type;
+
+    void sort( container_type& cont )
+    {
+        size_t size = cont.size();
+        if( size < 2 )
+            return;
+
+        // Kept elements are compacted to [0, out), always in order
+        container_type stragglers;
+        size_t out = 0;
+        size_t end = (size > array_size) ? size - array_size : 0;
+        size_t i = 0;
+        while( i < size )
+        {
+            if( i < end )
+            {
+                auto cmp = loadu< value_type, TAG_T >( &cont[i] );
+                auto next = loadu< value_type, TAG_T >( &cont[i+1] );
+                uint32_t mask = result_to_mask< value_type, TAG_T >(
+                                    greater_than< value_type, TAG_T >( cmp, next ) ) & inner_mask;
+                if( mask == 0 && (out == 0 || !(cont[i] < cont[out-1])) )
+                {
+                    storeu< value_type, TAG_T >( &cont[out], cmp );
+                    out += array_size;
+                    i += array_size;
+                    continue;
+                }
+            }
+
+            // Out of order: both the element and the last kept one leave
+            value_type val = cont[i++];
+            if( out == 0 || !(val < cont[out-1]) )
+            {
+                cont[ out++ ] = val;
+            }
+            else
+            {
+                stragglers.push_back( val );
+                stragglers.push_back( cont[ --out ] );
+            }
+        }
+
+        if( stragglers.empty() )
+            return;
+
+        std::sort( stragglers.begin(), stragglers.end() );
+
+        // Merge back from the end, [out, size) is free. Kept registers above the next
+        // straggler move as a whole.
+        size_t pos = size;
+        size_t left = stragglers.size();
+        while( left > 0 )
+        {
+            value_type val = stragglers[ left - 1 ];
+            if( out >= array_size &&
+                less_than_mask< value_type, TAG_T >(
+                    val, loadu< value_type, TAG_T >( &cont[ out - array_size ] ) ) == full_mask )
+            {
+                pos -= array_size;
+                out -= array_size;
+                storeu< value_type, TAG_T >( &cont[pos],
+                                             loadu< value_type, TAG_T >( &cont[out] ) );
+            }
+            else if( out > 0 && val < cont[ out - 1 ] )
+            {
+                cont[ --pos ] = cont[ --out ];
+            }
+            else
+            {
+                cont[ --pos ] = val;
+                --left;
+            }
+        }
+    }
+
+private:
+    constexpr static size_t array_size = traits< value_type, TAG_T >::simd_size;
+    constexpr static uint32_t full_mask =
+        static_cast< uint32_t >( (1ull << sizeof(simd_type)) - 1 );
+    constexpr static uint32_t inner_mask = full_mask >> sizeof(value_type);
+};
+
 }} // namespace simd_algoriths::bubble_sort
 
 #endif // SIMD_ALGORITHMS_BUBBLE_SORT_H
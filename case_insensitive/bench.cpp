@@ -0,0 +1,163 @@
+// MIT License
+//
+// Copyright (c) 2018 André Tupinambá
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "case_insensitive.h"
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <numeric>
+#include <strings.h>
+#include <boost/timer/timer.hpp>
+
+bool g_verbose = true;
+namespace sa = simd_algorithms;
+
+void do_nothing( const sa::aligned_string& );
+void do_nothing( size_t );
+
+// Lowercase copies of both sides, then an exact compare and search
+struct copy_case
+{
+    static sa::aligned_string lower( boost::string_view str )
+    {
+        sa::aligned_string ret( str.data(), str.size() );
+        sa::string_algo::to_lower< sa::avx_tag >()( ret );
+        return ret;
+    }
+
+    bool equals( boost::string_view lhs, boost::string_view rhs )
+    {
+        return lower( lhs ) == lower( rhs );
+    }
+
+    size_t find( boost::string_view haystack, boost::string_view needle )
+    {
+        return lower( haystack ).find( lower( needle ) );
+    }
+};
+
+struct libc_case
+{
+    bool equals( boost::string_view lhs, boost::string_view rhs )
+    {
+        return lhs.size() == rhs.size() && strncasecmp( lhs.data(), rhs.data(), lhs.size() ) == 0;
+    }
+
+    size_t find( boost::string_view haystack, boost::string_view needle )
+    {
+        const char* pos = strcasestr( haystack.data(), needle.data() );
+        return (pos == nullptr) ? boost::string_view::npos : pos - haystack.data();
+    }
+};
+
+template< typename TAG_T >
+struct simd_case
+{
+    bool equals( boost::string_view lhs, boost::string_view rhs )
+    {
+        return sa::string_algo::iequals< TAG_T >( lhs, rhs );
+    }
+
+    size_t find( boost::string_view haystack, boost::string_view needle )
+    {
+        return sa::string_algo::ifind< TAG_T >( haystack, needle );
+    }
+};
+
+sa::aligned_string make_text( size_t size )
+{
+    sa::aligned_string ret( size, ' ' );
+    srand(1);
+    std::generate( ret.begin(), ret.end(), []{ return static_cast< char >( 'a' + rand() % 26 ); } );
+    return ret;
+}
+
+template< typename CASE_T >
+uint64_t bench( const std::string& name, size_t size, size_t loop )
+{
+    boost::timer::cpu_timer timer;
+    CASE_T func;
+
+    sa::aligned_string lhs = make_text( size );
+    sa::aligned_string rhs( lhs );
+    std::transform( rhs.begin(), rhs.end(), rhs.begin(), []( char ch ){ return ch - 0x20; } );
+    sa::aligned_string needle = "Content-Length";
+    lhs.replace( size - needle.size(), needle.size(), "CONTENT-LENGTH" );
+
+    timer.start();
+    for( size_t j = 0; j < loop; ++j )
+    {
+        do_nothing( func.equals( lhs, rhs ) );
+        do_nothing( func.find( lhs, needle ) );
+    }
+    timer.stop();
+    if( g_verbose )
+        std::cout << "Case insensitive " << name << ": " << timer.format();
+
+    return timer.elapsed().wall;
+}
+
+int main(int argc, char* /*argv*/[])
+{
+    constexpr size_t runSize = 0x00010001;
+    constexpr size_t loop = 10000;
+    if( argc > 1 )
+    {
+        g_verbose = false;
+        std::cout << "count,base,sse,avx" << std::endl;
+    }
+    else
+    {
+        std::cout << "\nsize: 0x" << std::hex << std::setw(8) << std::setfill( '0') << runSize << std::endl << std::endl;
+    }
+    size_t cnt = 0;
+    while( 1 )
+    {
+        uint64_t base = bench< copy_case >( "Copy ", runSize, loop );
+        uint64_t sse = bench< simd_case< sa::sse_tag > >( "SSE .", runSize, loop );
+        uint64_t avx = bench< simd_case< sa::avx_tag > >( "AVX .", runSize, loop );
+
+        if( g_verbose )
+        {
+            bench< libc_case >( "libc ", runSize, loop );
+            std::cout
+                      << std::endl << "Speed up SSE.......: " << std::fixed << std::setprecision(2)
+                      << static_cast<float>(base)/static_cast<float>(sse) << "x"
+
+                      << std::endl << "Speed up AVX.......: " << std::fixed << std::setprecision(2)
+                      << static_cast<float>(base)/static_cast<float>(avx) << "x"
+
+                      << std::endl << std::endl;
+        }
+        else
+        {
+            std::cout
+                << ++cnt << ","
+                << base << ","
+                << sse << ","
+                << avx
+                << std::endl;
+        }
+    }
+    return 0;
+}
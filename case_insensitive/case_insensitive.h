@@ -0,0 +1,230 @@
+// MIT License
+//
+// Copyright (c) 2018 André Tupinambá
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef SIMD_ALGORITHMS_CASE_INSENSITIVE_H
+#define SIMD_ALGORITHMS_CASE_INSENSITIVE_H
+
+#include <algorithm>
+#include <boost/utility/string_view.hpp>
+#include "../simd_compare.h"
+#include "../to_lower/to_lower.h"
+
+namespace simd_algorithms{
+namespace string_algo{
+
+// ASCII case insensitive compare, hash and search. Both sides are folded with to_lower inside
+// the register loop, no lowercase copy is made. Lengths that are not a multiple of the register
+// size end with one last register overlapping the previous one.
+
+template< typename TAG_T >
+inline bool iequals( boost::string_view lhs, boost::string_view rhs )
+{
+    constexpr static size_t array_size = traits< char, TAG_T >::simd_size;
+    constexpr static uint32_t all_equal = (array_size == 32) ? 0xffffffff : 0xffff;
+    using fold = to_lower< TAG_T >;
+
+    if( lhs.size() != rhs.size() )
+        return false;
+
+    size_t size = lhs.size();
+    if( size < array_size )
+    {
+        for( size_t i = 0; i < size; ++i )
+        {
+            if( fold::apply( lhs[i] ) != fold::apply( rhs[i] ) )
+                return false;
+        }
+        return true;
+    }
+
+    auto equal_at = [&]( size_t i )
+    {
+        return all_equal == result_to_mask< char, TAG_T >(
+                equal< char, TAG_T >( fold::apply( loadu< char, TAG_T >( lhs.data() + i ) ),
+                                      fold::apply( loadu< char, TAG_T >( rhs.data() + i ) ) ) );
+    };
+
+    for( size_t i = 0; i + array_size <= size; i += array_size )
+    {
+        if( !equal_at( i ) )
+            return false;
+    }
+    return equal_at( size - array_size );
+}
+
+// strcasecmp order: negative, zero or positive comparing the lowercase unsigned bytes
+template< typename TAG_T >
+inline int icompare( boost::string_view lhs, boost::string_view rhs )
+{
+    constexpr static size_t array_size = traits< char, TAG_T >::simd_size;
+    constexpr static uint32_t all_equal = (array_size == 32) ? 0xffffffff : 0xffff;
+    using fold = to_lower< TAG_T >;
+
+    auto diff = [&]( size_t i )
+    {
+        return static_cast< int >( static_cast< unsigned char >( fold::apply( lhs[i] ) ) )
+             - static_cast< int >( static_cast< unsigned char >( fold::apply( rhs[i] ) ) );
+    };
+
+    size_t size = std::min( lhs.size(), rhs.size() );
+    size_t i = 0;
+    if( size >= array_size )
+    {
+        while( true )
+        {
+            uint32_t mask = result_to_mask< char, TAG_T >(
+                equal< char, TAG_T >( fold::apply( loadu< char, TAG_T >( lhs.data() + i ) ),
+                                      fold::apply( loadu< char, TAG_T >( rhs.data() + i ) ) ) );
+            if( mask != all_equal )
+                return diff( i + _bit_scan_forward( ~mask ) );
+
+            if( i + array_size == size )
+                break;
+
+            i = std::min( i + array_size, size - array_size );
+        }
+        i = size;
+    }
+
+    for( ; i < size; ++i )
+    {
+        int ret = diff( i );
+        if( ret != 0 )
+            return ret;
+    }
+    return (lhs.size() < rhs.size()) ? -1 : (lhs.size() > rhs.size()) ? 1 : 0;
+}
+
+// Hash of the lowercase bytes taken as little endian 64 bit words. The words are the same for
+// every register size, so SSE and AVX give the same hash.
+template< typename TAG_T >
+struct ihash
+{
+    size_t operator()( boost::string_view str ) const
+    {
+        constexpr static size_t array_size = traits< char, TAG_T >::simd_size;
+        using fold = to_lower< TAG_T >;
+
+        uint64_t hash = str.size() * mul;
+        size_t i = 0;
+        for( ; i + array_size <= str.size(); i += array_size )
+        {
+            uint64_t words[ array_size / sizeof(uint64_t) ];
+            storeu< char, TAG_T >( reinterpret_cast< char* >( words ),
+                                   fold::apply( loadu< char, TAG_T >( str.data() + i ) ) );
+            for( uint64_t word : words )
+            {
+                hash = mix( hash, word );
+            }
+        }
+
+        for( ; i < str.size(); i += sizeof(uint64_t) )
+        {
+            uint64_t word = 0;
+            size_t len = std::min( sizeof(uint64_t), str.size() - i );
+            for( size_t j = 0; j < len; ++j )
+            {
+                word |= static_cast< uint64_t >(
+                            static_cast< unsigned char >( fold::apply( str[i + j] ) ) ) << (8 * j);
+            }
+            hash = mix( hash, word );
+        }
+
+        // murmur3 finalizer
+        hash ^= hash >> 33;
+        hash *= 0xff51afd7ed558ccdULL;
+        hash ^= hash >> 33;
+        hash *= 0xc4ceb9fe1a85ec53ULL;
+        hash ^= hash >> 33;
+        return hash;
+    }
+
+private:
+    constexpr static uint64_t mul = 0x9e3779b97f4a7c15ULL;
+
+    static uint64_t mix( uint64_t hash, uint64_t word )
+    {
+        return ((hash << 5 | hash >> 59) ^ word) * mul;
+    }
+};
+
+// Equality predicate to pair with ihash in unordered containers
+template< typename TAG_T >
+struct iequal_to
+{
+    bool operator()( boost::string_view lhs, boost::string_view rhs ) const
+    {
+        return iequals< TAG_T >( lhs, rhs );
+    }
+};
+
+// Case insensitive memmem, position of the first match or npos. Candidates are the positions
+// where both the first and the last needle bytes match, checked one register at a time; the
+// rest of the needle is compared with iequals.
+template< typename TAG_T >
+inline size_t ifind( boost::string_view haystack, boost::string_view needle )
+{
+    constexpr static size_t array_size = traits< char, TAG_T >::simd_size;
+    using simd_type = typename traits< char, TAG_T >::simd_type;
+    using fold = to_lower< TAG_T >;
+
+    if( needle.empty() )
+        return 0;
+    if( needle.size() > haystack.size() )
+        return boost::string_view::npos;
+
+    size_t last = needle.size() - 1;
+    size_t end = haystack.size() - last;
+    char first_ch = fold::apply( needle.front() );
+    char last_ch = fold::apply( needle.back() );
+    boost::string_view middle = needle.substr( 1, (last > 0) ? last - 1 : 0 );
+
+    size_t i = 0;
+    for( ; i + array_size <= end; i += array_size )
+    {
+        simd_type first_block = fold::apply( loadu< char, TAG_T >( haystack.data() + i ) );
+        simd_type last_block = fold::apply( loadu< char, TAG_T >( haystack.data() + i + last ) );
+        uint32_t mask = result_to_mask< char, TAG_T >(
+            mask_and< TAG_T >( equal< char, TAG_T >( first_block, first_ch ),
+                               equal< char, TAG_T >( last_block, last_ch ) ) );
+        while( mask != 0 )
+        {
+            size_t pos = i + _bit_scan_forward( mask );
+            if( iequals< TAG_T >( haystack.substr( pos + 1, middle.size() ), middle ) )
+                return pos;
+            mask &= mask - 1;
+        }
+    }
+
+    for( ; i < end; ++i )
+    {
+        if( fold::apply( haystack[i] ) == first_ch
+            && fold::apply( haystack[i + last] ) == last_ch
+            && iequals< TAG_T >( haystack.substr( i + 1, middle.size() ), middle ) )
+            return i;
+    }
+    return boost::string_view::npos;
+}
+
+}} // namespace simd_algorithms::string_algo
+
+#endif // SIMD_ALGORITHMS_CASE_INSENSITIVE_H
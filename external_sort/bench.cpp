@@ -0,0 +1,166 @@
+// MIT License
+//
+// Copyright (c) 2018 André Tupinambá
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "external_sort.h"
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <numeric>
+#include <boost/filesystem.hpp>
+#include <boost/timer/timer.hpp>
+
+bool g_verbose = true;
+namespace sa = simd_algorithms;
+namespace fs = boost::filesystem;
+
+void do_nothing( int32_t );
+void do_nothing( size_t );
+
+template< class Cont_T, typename TAG_T >
+struct stl_sort
+{
+	using container_type = Cont_T;
+
+    void sort( container_type& cont )
+    {
+        std::sort( std::begin( cont ), std::end( cont ) );
+    }
+};
+
+void write_keys( const fs::path& name, size_t size )
+{
+    sa::sort::page_aligned_vector< int32_t > org;
+    srand(1);
+    std::generate_n( std::back_inserter(org), size, &rand );
+    FILE* out = fopen( name.c_str(), "wb" );
+    fwrite( org.data(), sizeof(int32_t), org.size(), out );
+    fclose( out );
+}
+
+bool check_keys( const fs::path& name, size_t size )
+{
+    sa::sort::page_aligned_vector< int32_t > keys( size );
+    FILE* in = fopen( name.c_str(), "rb" );
+    size_t count = fread( keys.data(), sizeof(int32_t), keys.size(), in );
+    fclose( in );
+    return count == size && std::is_sorted( keys.begin(), keys.end() );
+}
+
+uint64_t bench_memory( const std::string& name, const fs::path& input, size_t size, size_t loop )
+{
+    boost::timer::cpu_timer timer;
+    timer.start();
+    for( size_t j = 0; j < loop; ++j )
+    {
+        sa::sort::page_aligned_vector< int32_t > keys( size );
+        FILE* in = fopen( input.c_str(), "rb" );
+        do_nothing( fread( keys.data(), sizeof(int32_t), keys.size(), in ) );
+        fclose( in );
+        std::sort( keys.begin(), keys.end() );
+        do_nothing( keys[ size / 2 ] );
+    }
+    timer.stop();
+    if( g_verbose )
+        std::cout << "Sort file " << name << ": " << timer.format();
+
+    return timer.elapsed().wall;
+}
+
+template< template< typename...> class Sort_T, typename TAG_T >
+uint64_t bench( const std::string& name, const fs::path& input, size_t size, size_t loop,
+                size_t memory, bool direct_io )
+{
+    using sort_type = sa::sort::external< int32_t, TAG_T, Sort_T >;
+
+    boost::timer::cpu_timer timer;
+    fs::path output = fs::temp_directory_path() / fs::unique_path();
+    sort_type sort( memory, fs::temp_directory_path().string(), direct_io );
+
+    timer.start();
+    for( size_t j = 0; j < loop; ++j )
+    {
+        sort.sort( input.string(), output.string() );
+    }
+    timer.stop();
+    if( !check_keys( output, size ) )
+    {
+        std::cout << name << " output is not sorted" << std::endl;
+    }
+    fs::remove( output );
+
+    if( g_verbose )
+        std::cout << "Sort file " << name << ": " << timer.format();
+
+    return timer.elapsed().wall;
+}
+
+int main(int argc, char* /*argv*/[])
+{
+    constexpr size_t runSize = 0x01000000;
+    constexpr size_t memory = 0x00800000;
+    constexpr size_t loop = 1;
+    if( argc > 1 )
+    {
+        g_verbose = false;
+        std::cout << "count,in memory,external,external direct" << std::endl;
+    }
+    else
+    {
+        std::cout << "\nsize: 0x" << std::hex << std::setw(8) << std::setfill( '0') << runSize
+                  << ", memory: 0x" << std::setw(8) << std::setfill( '0') << memory << std::endl << std::endl;
+    }
+
+    fs::path input = fs::temp_directory_path() / fs::unique_path();
+    write_keys( input, runSize );
+
+    size_t cnt = 0;
+    while( 1 )
+    {
+        uint64_t base = bench_memory( "in memory .......", input, runSize, loop );
+        uint64_t ext = bench< stl_sort, sa::sse_tag >( "external ........", input, runSize, loop,
+                                                       memory, false );
+        uint64_t direct = bench< stl_sort, sa::sse_tag >( "external direct .", input, runSize, loop,
+                                                          memory, true );
+
+        if( g_verbose )
+        {
+            std::cout
+                << std::endl << "External slow down ........: " << std::fixed << std::setprecision(2)
+                << static_cast<float>(ext)/static_cast<float>(base) << "x"
+                << std::endl << "External direct slow down .: " << std::fixed << std::setprecision(2)
+                << static_cast<float>(direct)/static_cast<float>(base) << "x"
+
+                << std::endl << std::endl;
+        }
+        else
+        {
+            std::cout
+                << ++cnt << ","
+                << base << ","
+                << ext << ","
+                << direct
+                << std::endl;
+        }
+    }
+    return 0;
+}
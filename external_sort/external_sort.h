@@ -0,0 +1,357 @@
+// MIT License
+//
+// Copyright (c) 2018 André Tupinambá
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef SIMD_ALGORITHMS_EXTERNAL_SORT_H
+#define SIMD_ALGORITHMS_EXTERNAL_SORT_H
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+#include <boost/align/aligned_allocator.hpp>
+#include "../simd_compare.h"
+
+namespace simd_algorithms{
+namespace sort{
+
+// Page aligned vector, required by O_DIRECT transfers
+// ------------------------------------------------------------------------------------------------
+template< typename Val_T >
+using page_aligned_vector = std::vector< Val_T, boost::alignment::aligned_allocator<Val_T, 4096> >;
+
+// Sorts a file of raw value_type keys that does not fit in memory. Chunks of memory_size
+// bytes are sorted in memory with Sort_T and spilled to temp_dir as runs, then the runs are
+// merged with a k-way merge. Every transfer is a large sequential read or write, and no more
+// than memory_size bytes of buffers are alive at any time.
+template< typename Value_T, typename TAG_T, template< typename... > class Sort_T >
+class external
+{
+public:
+    using value_type     = Value_T;
+    using container_type = page_aligned_vector< value_type >;
+    using sort_type      = Sort_T< container_type, TAG_T >;
+
+    external( size_t memory_size, const std::string& temp_dir, bool direct_io = false )
+        : memory_size_( std::max( memory_size, 2 * min_buffer ) ),
+          temp_dir_( temp_dir ),
+          direct_io_( direct_io ){}
+
+    void sort( const std::string& input, const std::string& output )
+    {
+        run_files runs;
+        make_runs( input, runs );
+
+        // Merge passes until every run fits in one final merge
+        size_t fan_in = std::max< size_t >( 2, memory_size_ / min_buffer - 1 );
+        while( runs.size() > fan_in )
+        {
+            run_files next;
+            for( size_t i = 0; i < runs.size(); i += fan_in )
+            {
+                merge( runs, i, std::min( runs.size(), i + fan_in ), next.add( temp_name() ) );
+            }
+            runs.swap( next );
+        }
+        merge( runs, 0, runs.size(), output );
+    }
+
+private:
+    constexpr static size_t block_size = 4096;
+    constexpr static size_t min_buffer = 0x00100000;
+    constexpr static size_t block_count = block_size / sizeof(value_type);
+
+    size_t memory_size_;
+    std::string temp_dir_;
+    bool direct_io_;
+    size_t temp_count_ = 0;
+
+    // File helpers
+    // --------------------------------------------------------------------------------------------
+    class file
+    {
+    public:
+        file( const std::string& name, int flags, bool direct_io )
+            : direct_( direct_io )
+        {
+            fd_ = open( name, flags | (direct_ ? O_DIRECT : 0) );
+            if( fd_ < 0 && direct_ && errno == EINVAL )
+            {
+                // File system without O_DIRECT support
+                direct_ = false;
+                fd_ = open( name, flags );
+            }
+            if( fd_ < 0 )
+                throw std::system_error( errno, std::generic_category(), "open " + name );
+
+            if( !direct_ )
+                posix_fadvise( fd_, 0, 0, POSIX_FADV_SEQUENTIAL );
+        }
+
+        ~file()
+        {
+            ::close( fd_ );
+        }
+
+        file( const file& ) = delete;
+        file& operator=( const file& ) = delete;
+
+        // Reads up to size bytes, returning less only at the end of the file
+        size_t read( void* buf, size_t size )
+        {
+            char* ptr = static_cast< char* >( buf );
+            size_t done = 0;
+            while( done < size )
+            {
+                ssize_t ret = ::read( fd_, ptr + done, size - done );
+                if( ret < 0 && errno == EINTR )
+                    continue;
+                if( ret < 0 )
+                    throw std::system_error( errno, std::generic_category(), "read" );
+                if( ret == 0 )
+                    break;
+                done += ret;
+            }
+            return done;
+        }
+
+        void write( const void* buf, size_t size )
+        {
+            // O_DIRECT only takes whole blocks, the last partial one goes through the cache
+            if( direct_ && (size % block_size) != 0 )
+            {
+                fcntl( fd_, F_SETFL, fcntl( fd_, F_GETFL ) & ~O_DIRECT );
+                direct_ = false;
+            }
+
+            const char* ptr = static_cast< const char* >( buf );
+            size_t done = 0;
+            while( done < size )
+            {
+                ssize_t ret = ::write( fd_, ptr + done, size - done );
+                if( ret < 0 && errno == EINTR )
+                    continue;
+                if( ret < 0 )
+                    throw std::system_error( errno, std::generic_category(), "write" );
+                done += ret;
+            }
+        }
+
+    private:
+        int fd_;
+        bool direct_;
+
+        static int open( const std::string& name, int flags )
+        {
+            return ::open( name.c_str(), flags, 0644 );
+        }
+    };
+
+    class run_reader
+    {
+    public:
+        run_reader( const std::string& name, size_t count, bool direct_io )
+            : file_( name, O_RDONLY, direct_io ), buffer_( count ){}
+
+        bool next( value_type& val )
+        {
+            if( pos_ == size_ )
+            {
+                size_ = file_.read( buffer_.data(), buffer_.size() * sizeof(value_type) )
+                      / sizeof(value_type);
+                pos_ = 0;
+                if( size_ == 0 )
+                    return false;
+            }
+            val = buffer_[ pos_++ ];
+            return true;
+        }
+
+    private:
+        file file_;
+        container_type buffer_;
+        size_t pos_ = 0;
+        size_t size_ = 0;
+    };
+
+    class run_writer
+    {
+    public:
+        run_writer( const std::string& name, size_t count, bool direct_io )
+            : file_( name, O_WRONLY | O_CREAT | O_TRUNC, direct_io )
+        {
+            buffer_.reserve( count );
+        }
+
+        void push( value_type val )
+        {
+            buffer_.push_back( val );
+            if( buffer_.size() == buffer_.capacity() )
+                flush();
+        }
+
+        void flush()
+        {
+            file_.write( buffer_.data(), buffer_.size() * sizeof(value_type) );
+            buffer_.clear();
+        }
+
+    private:
+        file file_;
+        container_type buffer_;
+    };
+
+    // Run file names, unlinked when removed or when the owner goes out of scope, so a failed
+    // sort leaves nothing behind in temp_dir
+    class run_files
+    {
+    public:
+        run_files() = default;
+
+        ~run_files()
+        {
+            remove( 0, names_.size() );
+        }
+
+        run_files( const run_files& ) = delete;
+        run_files& operator=( const run_files& ) = delete;
+
+        // Owns the name before its file is created
+        const std::string& add( std::string name )
+        {
+            names_.push_back( std::move( name ) );
+            return names_.back();
+        }
+
+        const std::string& operator[]( size_t pos ) const
+        {
+            return names_[ pos ];
+        }
+
+        size_t size() const
+        {
+            return names_.size();
+        }
+
+        void swap( run_files& other )
+        {
+            names_.swap( other.names_ );
+        }
+
+        // Unlinks the files in [first, last)
+        void remove( size_t first, size_t last )
+        {
+            for( size_t i = first; i < last; ++i )
+            {
+                if( !names_[ i ].empty() )
+                    unlink( names_[ i ].c_str() );
+                names_[ i ].clear();
+            }
+        }
+
+    private:
+        std::vector< std::string > names_;
+    };
+
+    std::string temp_name()
+    {
+        return temp_dir_ + "/simd_sort_" + std::to_string( getpid() )
+                         + "_" + std::to_string( temp_count_++ ) + ".run";
+    }
+
+    // Whole number of blocks worth of values that fit in size bytes
+    static size_t buffer_count( size_t size )
+    {
+        return std::max< size_t >( 1, size / block_size ) * block_count;
+    }
+
+    // Run generation
+    // --------------------------------------------------------------------------------------------
+    void make_runs( const std::string& input, run_files& runs )
+    {
+        file in( input, O_RDONLY, direct_io_ );
+        sort_type sorter;
+
+        container_type chunk;
+        size_t count = buffer_count( memory_size_ );
+        while( true )
+        {
+            chunk.resize( count );
+            size_t size = in.read( chunk.data(), count * sizeof(value_type) ) / sizeof(value_type);
+            if( size == 0 )
+                break;
+
+            chunk.resize( size );
+            sorter.sort( chunk );
+
+            file out( runs.add( temp_name() ), O_WRONLY | O_CREAT | O_TRUNC, direct_io_ );
+            out.write( chunk.data(), size * sizeof(value_type) );
+
+            if( size < count )
+                break;
+        }
+    }
+
+    // K-way merge, consumes the runs in [first, last)
+    // --------------------------------------------------------------------------------------------
+    void merge( run_files& runs, size_t first, size_t last, const std::string& output )
+    {
+        using head_type = std::pair< value_type, size_t >;
+
+        size_t count = buffer_count( memory_size_ / (last - first + 1) );
+        std::vector< std::unique_ptr< run_reader > > readers;
+        std::priority_queue< head_type, std::vector< head_type >, std::greater< head_type > > heads;
+        for( size_t i = first; i < last; ++i )
+        {
+            readers.emplace_back( new run_reader( runs[ i ], count, direct_io_ ) );
+            value_type val;
+            if( readers.back()->next( val ) )
+                heads.emplace( val, readers.size() - 1 );
+        }
+
+        run_writer out( output, count, direct_io_ );
+        while( !heads.empty() )
+        {
+            head_type head = heads.top();
+            heads.pop();
+            out.push( head.first );
+
+            value_type val;
+            if( readers[ head.second ]->next( val ) )
+                heads.emplace( val, head.second );
+        }
+        out.flush();
+
+        readers.clear();
+        runs.remove( first, last );
+    }
+};
+
+}} // namespace simd_algoriths::sort
+
+#endif // SIMD_ALGORITHMS_EXTERNAL_SORT_H
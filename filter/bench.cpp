@@ -0,0 +1,143 @@
+// MIT License
+//
+// Copyright (c) 2018 André Tupinambá
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "filter.h"
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <boost/timer/timer.hpp>
+
+bool g_verbose = true;
+namespace sa = simd_algorithms;
+namespace pr = simd_algorithms::predicate;
+
+void do_nothing( size_t );
+
+using container_type = sa::aligned_vector< int32_t >;
+
+template< typename TAG_T >
+struct scalar_filter
+{
+    static size_t run( const container_type& in, container_type& out )
+    {
+        out.clear();
+        for( auto val : in )
+        {
+            if( val > 0 && val != 7 )
+                out.push_back( val );
+        }
+        return out.size();
+    }
+};
+
+template< typename TAG_T >
+struct simd_filter
+{
+    static size_t run( const container_type& in, container_type& out )
+    {
+        out.clear();
+        return sa::filter< TAG_T >( in, pr::greater( 0 ) && !pr::equal_to( 7 ), out );
+    }
+};
+
+template< typename TAG_T >
+struct simd_indices
+{
+    static size_t run( const container_type& in, container_type& )
+    {
+        static sa::aligned_vector< uint32_t > out;
+        out.clear();
+        return sa::filter_indices< TAG_T >( in, pr::greater( 0 ) && !pr::equal_to( 7 ), out );
+    }
+};
+
+template< template < typename > class FILTER_T, typename TAG_T >
+uint64_t bench( const std::string& name, const container_type& in, size_t loop )
+{
+    boost::timer::cpu_timer timer;
+    container_type out;
+    out.reserve( in.size() + 8 );
+
+    timer.start();
+    for( size_t j = 0; j < loop; ++j )
+    {
+        do_nothing( FILTER_T< TAG_T >::run( in, out ) );
+    }
+    timer.stop();
+    if( g_verbose )
+        std::cout << "Filter " << name << ": " << timer.format();
+
+    return timer.elapsed().wall;
+}
+
+int main(int argc, char* /*argv*/[])
+{
+    constexpr size_t runSize = 0x00400000;
+    constexpr size_t loop = 20;
+    if( argc > 1 )
+    {
+        g_verbose = false;
+        std::cout << "count,base,sse,avx,indices avx" << std::endl;
+    }
+    else
+    {
+        std::cout << "\nsize: 0x" << std::hex << std::setw(8) << std::setfill( '0') << runSize << std::endl << std::endl;
+    }
+
+    // Half of the values pass, the worst case for a branch
+    container_type in;
+    srand( 1 );
+    std::generate_n( std::back_inserter( in ), runSize, [](){ return rand() % 2000 - 1000; } );
+
+    size_t cnt = 0;
+    while( 1 )
+    {
+        uint64_t base = bench< scalar_filter, sa::sse_tag >( "scalar .....", in, loop );
+        uint64_t sse = bench< simd_filter, sa::sse_tag >( "SSE ........", in, loop );
+        uint64_t avx = bench< simd_filter, sa::avx_tag >( "AVX ........", in, loop );
+        uint64_t idx = bench< simd_indices, sa::avx_tag >( "indices AVX ", in, loop );
+
+        if( g_verbose )
+        {
+            std::cout
+                      << std::endl << "Speed up SSE.......: " << std::fixed << std::setprecision(2)
+                      << static_cast<float>(base)/static_cast<float>(sse) << "x"
+
+                      << std::endl << "Speed up AVX.......: " << std::fixed << std::setprecision(2)
+                      << static_cast<float>(base)/static_cast<float>(avx) << "x"
+
+                      << std::endl << std::endl;
+        }
+        else
+        {
+            std::cout
+                << ++cnt << ","
+                << base << ","
+                << sse << ","
+                << avx << ","
+                << idx
+                << std::endl;
+        }
+    }
+    return 0;
+}
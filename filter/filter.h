@@ -0,0 +1,271 @@
+// MIT License
+//
+// Copyright (c) 2018 André Tupinambá
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef SIMD_ALGORITHMS_FILTER_H
+#define SIMD_ALGORITHMS_FILTER_H
+
+#include <cstring>
+#include "../simd_compare.h"
+
+namespace simd_algorithms{
+namespace predicate{
+
+// Register predicates for filter. eval< TAG_T >( values ) returns a register with all bits set
+// in the lanes that pass. Any type deriving from base with that member can be combined with
+// &&, || and !, which evaluate both sides and join the masks with mask_and / mask_or / invert.
+template< typename Derived_T >
+struct base
+{
+    const Derived_T& self() const { return static_cast< const Derived_T& >( *this ); }
+};
+
+// value > key
+struct greater : base< greater >
+{
+    explicit greater( int32_t key ) : key_( key ){}
+
+    template< typename TAG_T >
+    typename traits< int32_t, TAG_T >::simd_type eval( typename traits< int32_t, TAG_T >::simd_type values ) const
+    {
+        return greater_than< int32_t, TAG_T >( values, broadcast< int32_t, TAG_T >( key_ ) );
+    }
+
+    int32_t key_;
+};
+
+// value < key
+struct less : base< less >
+{
+    explicit less( int32_t key ) : key_( key ){}
+
+    template< typename TAG_T >
+    typename traits< int32_t, TAG_T >::simd_type eval( typename traits< int32_t, TAG_T >::simd_type values ) const
+    {
+        return greater_than< int32_t, TAG_T >( broadcast< int32_t, TAG_T >( key_ ), values );
+    }
+
+    int32_t key_;
+};
+
+// value == key
+struct equal_to : base< equal_to >
+{
+    explicit equal_to( int32_t key ) : key_( key ){}
+
+    template< typename TAG_T >
+    typename traits< int32_t, TAG_T >::simd_type eval( typename traits< int32_t, TAG_T >::simd_type values ) const
+    {
+        return equal< int32_t, TAG_T >( values, broadcast< int32_t, TAG_T >( key_ ) );
+    }
+
+    int32_t key_;
+};
+
+// lo <= value <= hi
+struct between : base< between >
+{
+    between( int32_t lo, int32_t hi ) : lo_( lo ), hi_( hi ){}
+
+    template< typename TAG_T >
+    typename traits< int32_t, TAG_T >::simd_type eval( typename traits< int32_t, TAG_T >::simd_type values ) const
+    {
+        return invert< int32_t, TAG_T >(
+            mask_or< TAG_T >( greater_than< int32_t, TAG_T >( broadcast< int32_t, TAG_T >( lo_ ), values ),
+                              greater_than< int32_t, TAG_T >( values, broadcast< int32_t, TAG_T >( hi_ ) ) ) );
+    }
+
+    int32_t lo_;
+    int32_t hi_;
+};
+
+template< typename Lhs_T, typename Rhs_T >
+struct and_pred : base< and_pred< Lhs_T, Rhs_T > >
+{
+    and_pred( const Lhs_T& lhs, const Rhs_T& rhs ) : lhs_( lhs ), rhs_( rhs ){}
+
+    template< typename TAG_T >
+    typename traits< int32_t, TAG_T >::simd_type eval( typename traits< int32_t, TAG_T >::simd_type values ) const
+    {
+        return mask_and< TAG_T >( lhs_.template eval< TAG_T >( values ), rhs_.template eval< TAG_T >( values ) );
+    }
+
+    Lhs_T lhs_;
+    Rhs_T rhs_;
+};
+
+template< typename Lhs_T, typename Rhs_T >
+struct or_pred : base< or_pred< Lhs_T, Rhs_T > >
+{
+    or_pred( const Lhs_T& lhs, const Rhs_T& rhs ) : lhs_( lhs ), rhs_( rhs ){}
+
+    template< typename TAG_T >
+    typename traits< int32_t, TAG_T >::simd_type eval( typename traits< int32_t, TAG_T >::simd_type values ) const
+    {
+        return mask_or< TAG_T >( lhs_.template eval< TAG_T >( values ), rhs_.template eval< TAG_T >( values ) );
+    }
+
+    Lhs_T lhs_;
+    Rhs_T rhs_;
+};
+
+template< typename Pred_T >
+struct not_pred : base< not_pred< Pred_T > >
+{
+    explicit not_pred( const Pred_T& pred ) : pred_( pred ){}
+
+    template< typename TAG_T >
+    typename traits< int32_t, TAG_T >::simd_type eval( typename traits< int32_t, TAG_T >::simd_type values ) const
+    {
+        return invert< int32_t, TAG_T >( pred_.template eval< TAG_T >( values ) );
+    }
+
+    Pred_T pred_;
+};
+
+template< typename Lhs_T, typename Rhs_T >
+and_pred< Lhs_T, Rhs_T > operator&&( const base< Lhs_T >& lhs, const base< Rhs_T >& rhs )
+{
+    return and_pred< Lhs_T, Rhs_T >( lhs.self(), rhs.self() );
+}
+
+template< typename Lhs_T, typename Rhs_T >
+or_pred< Lhs_T, Rhs_T > operator||( const base< Lhs_T >& lhs, const base< Rhs_T >& rhs )
+{
+    return or_pred< Lhs_T, Rhs_T >( lhs.self(), rhs.self() );
+}
+
+template< typename Pred_T >
+not_pred< Pred_T > operator!( const base< Pred_T >& pred )
+{
+    return not_pred< Pred_T >( pred.self() );
+}
+
+} // namespace predicate
+
+// Stream compaction. The predicate is evaluated a register at a time, the lane mask selects a
+// compress permutation (pshufb table on SSE, vpermd table on AVX2, vpcompressd on AVX-512) and
+// the whole register is stored, the output pointer moves by the number of lanes that passed.
+// The last partial register is copied to a zero padded buffer and its extra lanes masked off.
+// Output buffers need size + array_size values of room.
+template< typename TAG_T >
+class filter_kernel
+{
+public:
+    using simd_type = typename traits< int32_t, TAG_T >::simd_type;
+    constexpr static size_t array_size = traits< int32_t, TAG_T >::simd_size;
+
+    // Copies the values that pass to out, returns how many
+    template< typename Pred_T >
+    static size_t values( const int32_t* data, size_t size, const Pred_T& pred, int32_t* out )
+    {
+        int32_t* dst = out;
+        size_t i = 0;
+        for( ; i + array_size <= size; i += array_size )
+        {
+            simd_type vals = loadu< int32_t, TAG_T >( data + i );
+            uint32_t mask = lane_mask< int32_t, TAG_T >( pred.template eval< TAG_T >( vals ) );
+            storeu< int32_t, TAG_T >( dst, compress< int32_t, TAG_T >( vals, mask ) );
+            dst += _mm_popcnt_u32( mask );
+        }
+        if( i < size )
+        {
+            simd_type vals = load_tail( data + i, size - i );
+            uint32_t mask = lane_mask< int32_t, TAG_T >( pred.template eval< TAG_T >( vals ) )
+                          & ((1u << (size - i)) - 1);
+            storeu< int32_t, TAG_T >( dst, compress< int32_t, TAG_T >( vals, mask ) );
+            dst += _mm_popcnt_u32( mask );
+        }
+        return dst - out;
+    }
+
+    // Writes the positions of the values that pass to out, returns how many
+    template< typename Pred_T >
+    static size_t indices( const int32_t* data, size_t size, const Pred_T& pred, uint32_t* out )
+    {
+        int32_t* dst = reinterpret_cast< int32_t* >( out );
+        simd_type index = first_indices();
+        size_t i = 0;
+        for( ; i + array_size <= size; i += array_size )
+        {
+            uint32_t mask = lane_mask< int32_t, TAG_T >(
+                pred.template eval< TAG_T >( loadu< int32_t, TAG_T >( data + i ) ) );
+            storeu< int32_t, TAG_T >( dst, compress< int32_t, TAG_T >( index, mask ) );
+            dst += _mm_popcnt_u32( mask );
+            index = add< int32_t, TAG_T >( index, array_size );
+        }
+        if( i < size )
+        {
+            uint32_t mask = lane_mask< int32_t, TAG_T >( pred.template eval< TAG_T >( load_tail( data + i, size - i ) ) )
+                          & ((1u << (size - i)) - 1);
+            storeu< int32_t, TAG_T >( dst, compress< int32_t, TAG_T >( index, mask ) );
+            dst += _mm_popcnt_u32( mask );
+        }
+        return dst - reinterpret_cast< int32_t* >( out );
+    }
+
+private:
+    static simd_type load_tail( const int32_t* data, size_t count )
+    {
+        int32_t tail[ array_size ] = {};
+        std::memcpy( tail, data, count * sizeof(int32_t) );
+        return loadu< int32_t, TAG_T >( tail );
+    }
+
+    static simd_type first_indices()
+    {
+        int32_t index[ array_size ];
+        for( size_t i = 0; i < array_size; ++i )
+        {
+            index[ i ] = static_cast< int32_t >( i );
+        }
+        return loadu< int32_t, TAG_T >( index );
+    }
+};
+
+// Appends the values of in that pass pred to out, returns how many
+template< typename TAG_T, typename Pred_T >
+size_t filter( const aligned_vector< int32_t >& in, const predicate::base< Pred_T >& pred,
+               aligned_vector< int32_t >& out )
+{
+    size_t old_size = out.size();
+    out.resize( old_size + in.size() + traits< int32_t, TAG_T >::simd_size );
+    size_t count = filter_kernel< TAG_T >::values( in.data(), in.size(), pred.self(), out.data() + old_size );
+    out.resize( old_size + count );
+    return count;
+}
+
+// Appends the positions in in of the values that pass pred to out, returns how many.
+// Positions are 32 bits, in must hold fewer than 2^32 values
+template< typename TAG_T, typename Pred_T >
+size_t filter_indices( const aligned_vector< int32_t >& in, const predicate::base< Pred_T >& pred,
+                       aligned_vector< uint32_t >& out )
+{
+    size_t old_size = out.size();
+    out.resize( old_size + in.size() + traits< int32_t, TAG_T >::simd_size );
+    size_t count = filter_kernel< TAG_T >::indices( in.data(), in.size(), pred.self(), out.data() + old_size );
+    out.resize( old_size + count );
+    return count;
+}
+
+} // namespace simd_algorithms
+
+#endif // SIMD_ALGORITHMS_FILTER_H
@@ -0,0 +1,174 @@
+// MIT License
+//
+// Copyright (c) 2018 André Tupinambá
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "hash_map.h"
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <numeric>
+#include <unordered_map>
+#include <boost/timer/timer.hpp>
+
+bool g_verbose = true;
+namespace sa = simd_algorithms;
+
+void do_nothing( int32_t );
+void do_nothing( size_t );
+
+template< typename TAG_T >
+struct std_lookup
+{
+    std::unordered_map< int32_t, int32_t > map_;
+
+    void insert( int32_t key, int32_t val ) { map_[ key ] = val; }
+
+    size_t find_all( const sa::aligned_vector< int32_t >& keys )
+    {
+        size_t ret = 0;
+        for( auto key : keys )
+        {
+            auto it = map_.find( key );
+            ret += (it != map_.end()) ? it->second : 0;
+        }
+        return ret;
+    }
+};
+
+template< typename TAG_T >
+struct simd_lookup
+{
+    sa::hash_map< int32_t, int32_t, TAG_T > map_;
+
+    void insert( int32_t key, int32_t val ) { map_[ key ] = val; }
+
+    size_t find_all( const sa::aligned_vector< int32_t >& keys )
+    {
+        size_t ret = 0;
+        for( auto key : keys )
+        {
+            auto it = map_.find( key );
+            ret += (it != map_.end()) ? it->second : 0;
+        }
+        return ret;
+    }
+};
+
+template< typename TAG_T >
+struct batch_lookup : simd_lookup< TAG_T >
+{
+    using iterator = typename sa::hash_map< int32_t, int32_t, TAG_T >::const_iterator;
+
+    size_t find_all( const sa::aligned_vector< int32_t >& keys )
+    {
+        constexpr size_t chunk = 1024;
+        iterator found[ chunk ];
+        size_t ret = 0;
+        for( size_t i = 0; i < keys.size(); i += chunk )
+        {
+            size_t len = std::min( chunk, keys.size() - i );
+            this->map_.find( keys.data() + i, len, found );
+            for( size_t j = 0; j < len; ++j )
+            {
+                ret += (found[j] != iterator( this->map_.end() )) ? found[j]->second : 0;
+            }
+        }
+        return ret;
+    }
+};
+
+template< template < typename > class LOOKUP_T, typename TAG_T >
+uint64_t bench( const std::string& name, size_t size, size_t loop )
+{
+    boost::timer::cpu_timer timer;
+    LOOKUP_T< TAG_T > lookup;
+
+    // Half of the searched keys are in the map
+    sa::aligned_vector< int32_t > keys;
+    srand( 1 );
+    std::generate_n( std::back_inserter( keys ), size, &rand );
+    for( size_t i = 0; i < size; i += 2 )
+    {
+        lookup.insert( keys[i], static_cast< int32_t >( i ) );
+    }
+
+    timer.start();
+    for( size_t j = 0; j < loop; ++j )
+    {
+        do_nothing( lookup.find_all( keys ) );
+    }
+    timer.stop();
+    if( g_verbose )
+        std::cout << "Find all " << name << ": " << timer.format();
+
+    return timer.elapsed().wall;
+}
+
+int main(int argc, char* /*argv*/[])
+{
+    constexpr size_t runSize = 0x00400000;
+    constexpr size_t loop = 10;
+    if( argc > 1 )
+    {
+        g_verbose = false;
+        std::cout << "count,base,sse,avx,batch avx" << std::endl;
+    }
+    else
+    {
+        std::cout << "\nsize: 0x" << std::hex << std::setw(8) << std::setfill( '0') << runSize << std::endl << std::endl;
+    }
+    size_t cnt = 0;
+    while( 1 )
+    {
+        uint64_t base = bench< std_lookup, sa::sse_tag >( "unordered_map", runSize, loop );
+        uint64_t sse = bench< simd_lookup, sa::sse_tag >( "hash_map SSE ", runSize, loop );
+        uint64_t avx = bench< simd_lookup, sa::avx_tag >( "hash_map AVX ", runSize, loop );
+        uint64_t batch = bench< batch_lookup, sa::avx_tag >( "batch AVX ...", runSize, loop );
+
+        if( g_verbose )
+        {
+            bench< batch_lookup, sa::sse_tag >( "batch SSE ...", runSize, loop );
+            std::cout
+                      << std::endl << "Speed up SSE.......: " << std::fixed << std::setprecision(2)
+                      << static_cast<float>(base)/static_cast<float>(sse) << "x"
+
+                      << std::endl << "Speed up AVX.......: " << std::fixed << std::setprecision(2)
+                      << static_cast<float>(base)/static_cast<float>(avx) << "x"
+
+                      << std::endl << "Speed up batch AVX.: " << std::fixed << std::setprecision(2)
+                      << static_cast<float>(base)/static_cast<float>(batch) << "x"
+
+                      << std::endl << std::endl;
+        }
+        else
+        {
+            std::cout
+                << ++cnt << ","
+                << base << ","
+                << sse << ","
+                << avx << ","
+                << batch
+                << std::endl;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,389 @@
+// MIT License
+//
+// Copyright (c) 2018 André Tupinambá
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef SIMD_ALGORITHMS_HASH_MAP_H
+#define SIMD_ALGORITHMS_HASH_MAP_H
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+#include "../simd_compare.h"
+
+namespace simd_algorithms{
+
+// std::hash is the identity for integers, the finalizer spreads the bits for H1 and H2
+template< typename Key_T >
+struct mix_hash
+{
+    size_t operator()( const Key_T& key ) const
+    {
+        uint64_t hash = std::hash< Key_T >()( key );
+        hash ^= hash >> 33;
+        hash *= 0xff51afd7ed558ccdULL;
+        hash ^= hash >> 33;
+        hash *= 0xc4ceb9fe1a85ec53ULL;
+        hash ^= hash >> 33;
+        return hash;
+    }
+};
+
+// Open addressing hash map with one control byte per slot (SwissTable). A full slot keeps the
+// low 7 bits of the hash (H2), empty and deleted slots are negative. Lookups probe a group of
+// array_size control bytes at a time with equal_mask and only compare keys where H2 matches;
+// the probe ends at the first group with an empty slot. The first group of control bytes is
+// mirrored after the last one so a group can start at any slot.
+//
+// Erase leaves a tombstone. When the table is full of tombstones it is rehashed in place,
+// otherwise it doubles. Iterators and pointers are invalidated by any insert.
+template< typename Key_T, typename Value_T, typename TAG_T, typename Hash_T = mix_hash< Key_T >,
+          typename Equal_T = std::equal_to< Key_T > >
+class hash_map
+{
+public:
+    using key_type = Key_T;
+    using mapped_type = Value_T;
+    using value_type = std::pair< Key_T, Value_T >;
+    using simd_type = typename traits< int8_t, TAG_T >::simd_type;
+    constexpr static size_t array_size = traits< int8_t, TAG_T >::simd_size;
+
+    template< bool Const_T >
+    class basic_iterator
+    {
+    public:
+        using map_type = typename std::conditional< Const_T, const hash_map, hash_map >::type;
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = typename hash_map::value_type;
+        using difference_type = std::ptrdiff_t;
+        using reference = typename std::conditional< Const_T, const value_type&, value_type& >::type;
+        using pointer = typename std::conditional< Const_T, const value_type*, value_type* >::type;
+
+        basic_iterator( map_type* map = nullptr, size_t pos = 0 ) : map_( map ), pos_( pos ){}
+
+        // iterator to const_iterator
+        operator basic_iterator< true >() const
+        {
+            return basic_iterator< true >( map_, pos_ );
+        }
+
+        reference operator*() const { return map_->slots_[ pos_ ]; }
+        pointer operator->() const { return &map_->slots_[ pos_ ]; }
+
+        basic_iterator& operator++()
+        {
+            pos_ = map_->next_full( pos_ + 1 );
+            return *this;
+        }
+
+        basic_iterator operator++( int )
+        {
+            basic_iterator ret( *this );
+            ++(*this);
+            return ret;
+        }
+
+        bool operator==( const basic_iterator& other ) const { return pos_ == other.pos_; }
+        bool operator!=( const basic_iterator& other ) const { return pos_ != other.pos_; }
+
+    private:
+        friend class hash_map;
+
+        map_type* map_;
+        size_t pos_;
+    };
+
+    using iterator = basic_iterator< false >;
+    using const_iterator = basic_iterator< true >;
+
+    hash_map( size_t capacity = 0 )
+    {
+        reserve( capacity );
+    }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    size_t capacity() const { return capacity_; }
+
+    iterator begin() { return iterator( this, next_full( 0 ) ); }
+    iterator end() { return iterator( this, capacity_ ); }
+    const_iterator begin() const { return const_iterator( this, next_full( 0 ) ); }
+    const_iterator end() const { return const_iterator( this, capacity_ ); }
+
+    // Room for count elements without growing
+    void reserve( size_t count )
+    {
+        size_t capacity = array_size;
+        while( capacity * 7 / 8 < count )
+        {
+            capacity *= 2;
+        }
+        if( capacity > capacity_ )
+            resize( capacity );
+    }
+
+    void clear()
+    {
+        std::fill( ctrl_.begin(), ctrl_.end(), empty_slot );
+        std::fill( slots_.begin(), slots_.end(), value_type() );
+        size_ = 0;
+        growth_left_ = capacity_ * 7 / 8;
+    }
+
+    iterator find( const key_type& key )
+    {
+        return iterator( this, find_pos( key, hash_( key ) ) );
+    }
+
+    const_iterator find( const key_type& key ) const
+    {
+        return const_iterator( this, find_pos( key, hash_( key ) ) );
+    }
+
+    // Looks up count keys, batch_size at a time: the hashes of a batch are computed and their
+    // first control group and slot prefetched before any of them is probed.
+    template< typename OutputIt_T >
+    OutputIt_T find( const key_type* keys, size_t count, OutputIt_T out ) const
+    {
+        constexpr size_t batch_size = 16;
+        size_t hashes[ batch_size ];
+        for( size_t i = 0; i < count; i += batch_size )
+        {
+            size_t len = std::min( batch_size, count - i );
+            for( size_t j = 0; j < len; ++j )
+            {
+                hashes[j] = hash_( keys[ i + j ] );
+                size_t pos = h1( hashes[j] ) & mask_;
+                _mm_prefetch( reinterpret_cast< const char* >( ctrl_.data() + pos ), _MM_HINT_T0 );
+                _mm_prefetch( reinterpret_cast< const char* >( slots_.data() + pos ), _MM_HINT_T0 );
+            }
+            for( size_t j = 0; j < len; ++j )
+            {
+                *out++ = const_iterator( this, find_pos( keys[ i + j ], hashes[j] ) );
+            }
+        }
+        return out;
+    }
+
+    size_t count( const key_type& key ) const
+    {
+        return (find_pos( key, hash_( key ) ) != capacity_) ? 1 : 0;
+    }
+
+    std::pair< iterator, bool > insert( const value_type& value )
+    {
+        size_t hash = hash_( value.first );
+        size_t pos = find_pos( value.first, hash );
+        if( pos != capacity_ )
+            return std::make_pair( iterator( this, pos ), false );
+
+        pos = prepare_insert( hash );
+        slots_[ pos ] = value;
+        return std::make_pair( iterator( this, pos ), true );
+    }
+
+    mapped_type& operator[]( const key_type& key )
+    {
+        return insert( value_type( key, mapped_type() ) ).first->second;
+    }
+
+    size_t erase( const key_type& key )
+    {
+        size_t pos = find_pos( key, hash_( key ) );
+        if( pos == capacity_ )
+            return 0;
+
+        erase_pos( pos );
+        return 1;
+    }
+
+    void erase( const_iterator it )
+    {
+        erase_pos( it.pos_ );
+    }
+
+private:
+    template< bool > friend class basic_iterator;
+
+    enum : int8_t { empty_slot = -128, deleted_slot = -2 };
+
+    // Capacity bytes plus the mirrored first group
+    aligned_vector< int8_t > ctrl_;
+    std::vector< value_type > slots_;
+    size_t capacity_ = 0;
+    size_t mask_ = 0;
+    size_t size_ = 0;
+    size_t growth_left_ = 0;
+    Hash_T hash_;
+    Equal_T equal_;
+
+    static size_t h1( size_t hash ) { return hash >> 7; }
+    static int8_t h2( size_t hash ) { return hash & 0x7f; }
+
+    simd_type group( size_t pos ) const
+    {
+        return loadu< int8_t, TAG_T >( ctrl_.data() + pos );
+    }
+
+    void set_ctrl( size_t pos, int8_t val )
+    {
+        ctrl_[ pos ] = val;
+        if( pos < array_size )
+            ctrl_[ capacity_ + pos ] = val;
+    }
+
+    size_t next_full( size_t pos ) const
+    {
+        while( pos < capacity_ && ctrl_[ pos ] < 0 )
+        {
+            ++pos;
+        }
+        return pos;
+    }
+
+    // Slot of key or capacity_. The probe moves a growing number of groups each step, which
+    // visits every group of a power of two table.
+    size_t find_pos( const key_type& key, size_t hash ) const
+    {
+        size_t pos = h1( hash ) & mask_;
+        for( size_t step = array_size; ; step += array_size )
+        {
+            simd_type ctrl = group( pos );
+            for( uint32_t match = equal_mask< int8_t, TAG_T >( h2( hash ), ctrl ); match != 0; match &= match - 1 )
+            {
+                size_t cur = (pos + _bit_scan_forward( match )) & mask_;
+                if( equal_( slots_[ cur ].first, key ) )
+                    return cur;
+            }
+            if( equal_mask< int8_t, TAG_T >( empty_slot, ctrl ) != 0 )
+                return capacity_;
+            pos = (pos + step) & mask_;
+        }
+    }
+
+    // First empty or deleted slot on the probe of hash
+    size_t find_free( size_t hash ) const
+    {
+        size_t pos = h1( hash ) & mask_;
+        for( size_t step = array_size; ; step += array_size )
+        {
+            uint32_t free = result_to_mask< int8_t, TAG_T >( group( pos ) );
+            if( free != 0 )
+                return (pos + _bit_scan_forward( free )) & mask_;
+            pos = (pos + step) & mask_;
+        }
+    }
+
+    size_t prepare_insert( size_t hash )
+    {
+        size_t pos = find_free( hash );
+        if( growth_left_ == 0 && ctrl_[ pos ] != deleted_slot )
+        {
+            // Mostly tombstones: clean them up, else grow
+            if( size_ * 16 <= capacity_ * 7 )
+                rehash_in_place();
+            else
+                resize( capacity_ * 2 );
+            pos = find_free( hash );
+        }
+
+        growth_left_ -= (ctrl_[ pos ] == empty_slot) ? 1 : 0;
+        set_ctrl( pos, h2( hash ) );
+        ++size_;
+        return pos;
+    }
+
+    void erase_pos( size_t pos )
+    {
+        set_ctrl( pos, deleted_slot );
+        slots_[ pos ] = value_type();
+        --size_;
+    }
+
+    void resize( size_t capacity )
+    {
+        aligned_vector< int8_t > old_ctrl( capacity + array_size, empty_slot );
+        std::vector< value_type > old_slots( capacity );
+        old_ctrl.swap( ctrl_ );
+        old_slots.swap( slots_ );
+        size_t old_capacity = capacity_;
+
+        capacity_ = capacity;
+        mask_ = capacity - 1;
+        growth_left_ = capacity * 7 / 8 - size_;
+
+        for( size_t i = 0; i < old_capacity; ++i )
+        {
+            if( old_ctrl[ i ] >= 0 )
+            {
+                size_t hash = hash_( old_slots[ i ].first );
+                size_t pos = find_free( hash );
+                set_ctrl( pos, h2( hash ) );
+                slots_[ pos ] = std::move( old_slots[ i ] );
+            }
+        }
+    }
+
+    // Drops the tombstones without growing. Full slots are marked deleted and tombstones empty,
+    // then each marked element goes to the first free slot of its probe: it stays if that is
+    // in the same probe group, moves to an empty slot or swaps with another marked element.
+    void rehash_in_place()
+    {
+        for( size_t i = 0; i < capacity_; ++i )
+        {
+            set_ctrl( i, (ctrl_[ i ] >= 0) ? deleted_slot : empty_slot );
+        }
+
+        for( size_t i = 0; i < capacity_; ++i )
+        {
+            if( ctrl_[ i ] != deleted_slot )
+                continue;
+
+            size_t hash = hash_( slots_[ i ].first );
+            size_t pos = find_free( hash );
+            size_t start = h1( hash ) & mask_;
+            auto probe_group = [&]( size_t p ){ return ((p - start) & mask_) / array_size; };
+
+            if( probe_group( pos ) == probe_group( i ) )
+            {
+                set_ctrl( i, h2( hash ) );
+            }
+            else if( ctrl_[ pos ] == empty_slot )
+            {
+                set_ctrl( pos, h2( hash ) );
+                slots_[ pos ] = std::move( slots_[ i ] );
+                set_ctrl( i, empty_slot );
+            }
+            else
+            {
+                set_ctrl( pos, h2( hash ) );
+                std::swap( slots_[ pos ], slots_[ i ] );
+                --i;
+            }
+        }
+        growth_left_ = capacity_ * 7 / 8 - size_;
+    }
+};
+
+} // namespace simd_algorithms
+
+#endif // SIMD_ALGORITHMS_HASH_MAP_H
@@ -0,0 +1,150 @@
+// MIT License
+//
+// Copyright (c) 2018 André Tupinambá
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "learned.h"
+#include "../nway_tree/nway_tree.h"
+#include "../binary_search/binary_search.h"
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <boost/timer/timer.hpp>
+
+bool g_verbose = true;
+namespace sa = simd_algorithms;
+
+void do_nothing( int32_t );
+
+using container_type = sa::aligned_vector< int32_t >;
+
+template< template < typename... > class Index_T, typename TAG_T >
+uint64_t bench( const std::string& name, const container_type& sorted, const container_type& keys, size_t loop )
+{
+    using index_type = Index_T< container_type, TAG_T >;
+
+    boost::timer::cpu_timer timer;
+    index_type index( sorted );
+    index.build_index();
+
+    timer.start();
+    for( size_t j = 0; j < loop; ++j )
+    {
+        for( auto key : keys )
+        {
+            auto ret = index.find( key );
+            do_nothing( (ret != sorted.end()) ? *ret : 0 );
+        }
+    }
+    timer.stop();
+    if( g_verbose )
+        std::cout << "Find " << name << ": " << timer.format();
+
+    return timer.elapsed().wall;
+}
+
+int main(int argc, char* /*argv*/[])
+{
+    constexpr size_t runSize = 0x00400000;
+    constexpr size_t loop = 4;
+    if( argc > 1 )
+    {
+        g_verbose = false;
+        std::cout << "count,cache random,nway random,learned random,cache sequential,nway sequential,learned sequential" << std::endl;
+    }
+    else
+    {
+        std::cout << "\nsize: 0x" << std::hex << std::setw(8) << std::setfill( '0') << runSize << std::endl << std::endl;
+    }
+
+    srand( 1 );
+    container_type random;
+    std::generate_n( std::back_inserter( random ), runSize, rand );
+    std::sort( random.begin(), random.end() );
+
+    // Timestamp like keys, one every 100 ticks with some jitter
+    container_type sequential;
+    for( size_t i = 0; i < runSize; ++i )
+    {
+        sequential.push_back( static_cast< int32_t >( i * 100 + rand() % 50 ) );
+    }
+
+    container_type randomKeys;
+    container_type sequentialKeys;
+    for( size_t i = 0; i < runSize; ++i )
+    {
+        randomKeys.push_back( random[ rand() % runSize ] );
+        sequentialKeys.push_back( sequential[ rand() % runSize ] );
+    }
+
+    if( g_verbose )
+    {
+        sa::learned::index< container_type, sa::avx_tag > randomIndex( random );
+        randomIndex.build_index();
+        sa::learned::index< container_type, sa::avx_tag > sequentialIndex( sequential );
+        sequentialIndex.build_index();
+        std::cout << "Segments random: " << std::dec << randomIndex.segment_count()
+                  << ", sequential: " << sequentialIndex.segment_count() << std::endl << std::endl;
+    }
+
+    size_t cnt = 0;
+    while( 1 )
+    {
+        uint64_t cacheRnd = bench< sa::binary_search::index_cache, sa::avx_tag >( "cache AVX random ........", random, randomKeys, loop );
+        uint64_t nwayRnd = bench< sa::nway_tree::index, sa::avx_tag >( "nway AVX random .........", random, randomKeys, loop );
+        uint64_t learnedRnd = bench< sa::learned::index, sa::avx_tag >( "learned AVX random ......", random, randomKeys, loop );
+        uint64_t cacheSeq = bench< sa::binary_search::index_cache, sa::avx_tag >( "cache AVX sequential ....", sequential, sequentialKeys, loop );
+        uint64_t nwaySeq = bench< sa::nway_tree::index, sa::avx_tag >( "nway AVX sequential .....", sequential, sequentialKeys, loop );
+        uint64_t learnedSeq = bench< sa::learned::index, sa::avx_tag >( "learned AVX sequential ..", sequential, sequentialKeys, loop );
+
+        if( g_verbose )
+        {
+            bench< sa::learned::index, sa::sse_tag >( "learned SSE sequential ..", sequential, sequentialKeys, loop );
+            std::cout
+                      << std::endl << "Speed up random vs cache......: " << std::fixed << std::setprecision(2)
+                      << static_cast<float>(cacheRnd)/static_cast<float>(learnedRnd) << "x"
+
+                      << std::endl << "Speed up random vs nway.......: " << std::fixed << std::setprecision(2)
+                      << static_cast<float>(nwayRnd)/static_cast<float>(learnedRnd) << "x"
+
+                      << std::endl << "Speed up sequential vs cache..: " << std::fixed << std::setprecision(2)
+                      << static_cast<float>(cacheSeq)/static_cast<float>(learnedSeq) << "x"
+
+                      << std::endl << "Speed up sequential vs nway...: " << std::fixed << std::setprecision(2)
+                      << static_cast<float>(nwaySeq)/static_cast<float>(learnedSeq) << "x"
+
+                      << std::endl << std::endl;
+        }
+        else
+        {
+            std::cout
+                << ++cnt << ","
+                << cacheRnd << ","
+                << nwayRnd << ","
+                << learnedRnd << ","
+                << cacheSeq << ","
+                << nwaySeq << ","
+                << learnedSeq
+                << std::endl;
+        }
+    }
+    return 0;
+}
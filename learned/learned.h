@@ -0,0 +1,180 @@
+// MIT License
+//
+// Copyright (c) 2018 André Tupinambá
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef SIMD_ALGORITHMS_LEARNED_H
+#define SIMD_ALGORITHMS_LEARNED_H
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include "../simd_compare.h"
+#include "../nway_tree/nway_tree.h"
+
+namespace simd_algorithms{
+namespace learned{
+
+// Piecewise linear index. build_index fits segments over the distinct keys with a shrinking
+// cone, so every key is predicted within error positions of its first occurrence. find takes the
+// segment from an nway_tree over the segment first keys, predicts the position and scans the
+// error window one register at a time.
+template< class Cont_T, typename TAG_T >
+class index
+{
+public:
+	using container_type = Cont_T;
+    using value_type     = typename container_type::value_type;
+    using const_iterator = typename container_type::const_iterator;
+
+    index( const container_type& ref, size_t error = 16 )
+        : ref_( ref ), error_( error ), top_( first_keys_ ){}
+
+    // The tree keeps a reference to first_keys_
+    index( const index& ) = delete;
+    index& operator=( const index& ) = delete;
+
+    void build_index()
+    {
+        first_keys_.clear();
+        segments_.clear();
+
+        size_t start = 0;
+        double slope_lo = 0;
+        double slope_hi = std::numeric_limits< double >::infinity();
+        for( size_t pos = 0; pos < ref_.size(); ++pos )
+        {
+            if( pos > start && !(ref_[ pos - 1 ] < ref_[ pos ]) )
+                continue;
+
+            double dx = static_cast< double >( ref_[ pos ] ) - static_cast< double >( ref_[ start ] );
+            double dy = static_cast< double >( pos - start );
+            if( pos > start && dy <= slope_hi * dx && dy >= slope_lo * dx )
+            {
+                slope_lo = std::max( slope_lo, (dy - error_) / dx );
+                slope_hi = std::min( slope_hi, (dy + error_) / dx );
+                continue;
+            }
+
+            // The point is out of the cone, or the first one
+            if( pos > start )
+            {
+                close_segment( start, slope_lo, slope_hi );
+            }
+            start = pos;
+            slope_lo = 0;
+            slope_hi = std::numeric_limits< double >::infinity();
+        }
+        if( !ref_.empty() )
+        {
+            close_segment( start, slope_lo, slope_hi );
+        }
+        top_.build_index();
+    }
+
+    const_iterator find( const value_type& key ) const
+    {
+        auto first = lower_bound( key );
+        return (first != ref_.end() && !(key < *first)) ? first : ref_.end();
+    }
+
+    // First value not less than key, end() when every value is less
+    const_iterator lower_bound( const value_type& key ) const
+    {
+        // Last segment whose first key is not greater than key
+        size_t seg = std::distance( first_keys_.cbegin(), top_.lower_bound( key ) );
+        if( seg == first_keys_.size() || key < first_keys_[ seg ] )
+        {
+            if( seg == 0 )
+                return ref_.begin();
+            --seg;
+        }
+
+        // The answer is in [seg_lo, seg_hi], the next segment first key is already greater
+        size_t seg_lo = segments_[ seg ].start;
+        size_t seg_hi = (seg + 1 < segments_.size()) ? segments_[ seg + 1 ].start : ref_.size();
+        double guess = seg_lo + segments_[ seg ].slope *
+                       (static_cast< double >( key ) - static_cast< double >( first_keys_[ seg ] ));
+        size_t predicted = static_cast< size_t >( std::min( std::max( guess, static_cast< double >( seg_lo ) ),
+                                                            static_cast< double >( seg_hi ) ) );
+        size_t lo = (predicted > seg_lo + error_) ? predicted - error_ : seg_lo;
+        size_t hi = std::min( predicted + error_ + 1, seg_hi );
+
+        size_t pos = scan( key, lo, hi );
+
+        // Duplicates and keys between segments may fall out of the window
+        if( (pos == lo && lo != seg_lo && !(ref_[ lo - 1 ] < key)) || (pos == hi && hi != seg_hi) )
+        {
+            return std::lower_bound( std::next( ref_.begin(), seg_lo ), std::next( ref_.begin(), seg_hi ), key );
+        }
+        return std::next( ref_.begin(), pos );
+    }
+
+    size_t segment_count() const
+    {
+        return segments_.size();
+    }
+
+private:
+    constexpr static size_t array_size = traits< value_type, TAG_T >::simd_size;
+
+    struct segment
+    {
+        double slope;
+        size_t start;
+    };
+
+    const container_type& ref_;
+    size_t error_;
+    aligned_vector< value_type > first_keys_;
+    aligned_vector< segment > segments_;
+    nway_tree::index< aligned_vector< value_type >, TAG_T > top_;
+
+    void close_segment( size_t start, double slope_lo, double slope_hi )
+    {
+        double slope = std::isinf( slope_hi ) ? 0 : (slope_lo + slope_hi) / 2;
+        first_keys_.push_back( ref_[ start ] );
+        segments_.push_back( segment{ slope, start } );
+    }
+
+    // Lower bound in [lo, hi), counting the values less than key a register at a time
+    size_t scan( const value_type& key, size_t lo, size_t hi ) const
+    {
+        size_t pos = lo;
+        while( pos + array_size <= hi )
+        {
+            uint32_t less = mask_to_count< value_type, TAG_T >(
+                greater_than_mask< value_type, TAG_T >( key, loadu< value_type, TAG_T >( &ref_[ pos ] ) ) );
+            pos += less;
+            if( less < array_size )
+                return pos;
+        }
+        while( pos < hi && ref_[ pos ] < key )
+        {
+            ++pos;
+        }
+        return pos;
+    }
+};
+
+}} // namespace simd_algoriths::learned
+
+#endif // SIMD_ALGORITHMS_LEARNED_H
@@ -0,0 +1,160 @@
+// MIT License
+//
+// Copyright (c) 2018 André Tupinambá
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "merge.h"
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cstring>
+#include <boost/timer/timer.hpp>
+
+bool g_verbose = true;
+namespace sa = simd_algorithms;
+
+void do_nothing( size_t );
+
+using container_type = sa::aligned_vector< int32_t >;
+
+template< typename TAG_T >
+struct std_merge
+{
+    static void run( const container_type& a, const container_type& b, container_type& out, size_t )
+    {
+        out.resize( a.size() + b.size() );
+        std::merge( a.begin(), a.end(), b.begin(), b.end(), out.begin() );
+    }
+};
+
+template< typename TAG_T >
+struct simd_merge
+{
+    static void run( const container_type& a, const container_type& b, container_type& out, size_t threads )
+    {
+        sa::merge< TAG_T >( a, b, out, threads );
+    }
+};
+
+// Lower bound, a plain copy of the same amount of data
+template< typename TAG_T >
+struct copy_only
+{
+    static void run( const container_type& a, const container_type& b, container_type& out, size_t )
+    {
+        out.resize( a.size() + b.size() );
+        std::memcpy( out.data(), a.data(), a.size() * sizeof(int32_t) );
+        std::memcpy( out.data() + a.size(), b.data(), b.size() * sizeof(int32_t) );
+    }
+};
+
+container_type make_sorted( size_t size )
+{
+    container_type ret;
+    std::generate_n( std::back_inserter( ret ), size, &rand );
+    std::sort( ret.begin(), ret.end() );
+    return ret;
+}
+
+template< template < typename > class MERGE_T, typename TAG_T >
+uint64_t bench( const std::string& name, const container_type& a, const container_type& b,
+                size_t loop, size_t threads )
+{
+    boost::timer::cpu_timer timer;
+    container_type out( a.size() + b.size() );
+
+    timer.start();
+    for( size_t j = 0; j < loop; ++j )
+    {
+        MERGE_T< TAG_T >::run( a, b, out, threads );
+        do_nothing( out.size() );
+    }
+    timer.stop();
+    if( g_verbose )
+        std::cout << "Merge " << name << ": " << timer.format();
+
+    return timer.elapsed().wall;
+}
+
+int main(int argc, char* /*argv*/[])
+{
+    constexpr size_t runSize = 0x00400000;
+    constexpr size_t loop = 10;
+    size_t threads = std::thread::hardware_concurrency();
+    if( argc > 1 )
+    {
+        g_verbose = false;
+        std::cout << "count,base,sse,avx,avx threads,delta base,delta avx" << std::endl;
+    }
+    else
+    {
+        std::cout << "\nsize: 0x" << std::hex << std::setw(8) << std::setfill( '0') << runSize
+                  << std::dec << ", threads: " << threads << std::endl << std::endl;
+    }
+
+    srand( 1 );
+    container_type a = make_sorted( runSize );
+    container_type b = make_sorted( runSize );
+    container_type delta = make_sorted( runSize / 100 );
+
+    size_t cnt = 0;
+    while( 1 )
+    {
+        uint64_t base = bench< std_merge, sa::sse_tag >( "std ..........", a, b, loop, 1 );
+        uint64_t sse = bench< simd_merge, sa::sse_tag >( "SSE ..........", a, b, loop, 1 );
+        uint64_t avx = bench< simd_merge, sa::avx_tag >( "AVX ..........", a, b, loop, 1 );
+        uint64_t par = bench< simd_merge, sa::avx_tag >( "AVX threads ..", a, b, loop, threads );
+        uint64_t delta_base = bench< std_merge, sa::sse_tag >( "delta std ....", a, delta, loop, 1 );
+        uint64_t delta_avx = bench< simd_merge, sa::avx_tag >( "delta AVX ....", a, delta, loop, 1 );
+
+        if( g_verbose )
+        {
+            bench< copy_only, sa::sse_tag >( "delta memcpy .", a, delta, loop, 1 );
+            std::cout
+                      << std::endl << "Speed up SSE.......: " << std::fixed << std::setprecision(2)
+                      << static_cast<float>(base)/static_cast<float>(sse) << "x"
+
+                      << std::endl << "Speed up AVX.......: " << std::fixed << std::setprecision(2)
+                      << static_cast<float>(base)/static_cast<float>(avx) << "x"
+
+                      << std::endl << "Speed up threads...: " << std::fixed << std::setprecision(2)
+                      << static_cast<float>(base)/static_cast<float>(par) << "x"
+
+                      << std::endl << "Speed up delta AVX.: " << std::fixed << std::setprecision(2)
+                      << static_cast<float>(delta_base)/static_cast<float>(delta_avx) << "x"
+
+                      << std::endl << std::endl;
+        }
+        else
+        {
+            std::cout
+                << ++cnt << ","
+                << base << ","
+                << sse << ","
+                << avx << ","
+                << par << ","
+                << delta_base << ","
+                << delta_avx
+                << std::endl;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,175 @@
+// MIT License
+//
+// Copyright (c) 2018 André Tupinambá
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef SIMD_ALGORITHMS_MERGE_H
+#define SIMD_ALGORITHMS_MERGE_H
+
+#include <algorithm>
+#include <utility>
+#include "../simd_compare.h"
+#include "../reduce/reduce.h"
+
+namespace simd_algorithms{
+
+// Merge of two sorted int32_t arrays. The pending register and the next register of the input
+// with the smallest head go through a bitonic network, the low half is final and stored. When
+// one input is much smaller (a delta merged into a main array) or is down to its last values,
+// the larger input is copied a register at a time and the small values are inserted where
+// they belong, so the merge moves at copy speed. Equal values of a come before those of b.
+template< typename TAG_T >
+class merger
+{
+public:
+    using simd_type = typename traits< int32_t, TAG_T >::simd_type;
+
+    constexpr static size_t array_size = traits< int32_t, TAG_T >::simd_size;
+    constexpr static size_t insert_ratio = 16;
+
+    static void merge( const int32_t* a, size_t na, const int32_t* b, size_t nb, int32_t* out )
+    {
+        if( na * insert_ratio < nb )
+            return insert_merge< false >( a, na, b, nb, out );
+        if( nb * insert_ratio < na )
+            return insert_merge< true >( b, nb, a, na, out );
+        if( na < array_size || nb < array_size )
+        {
+            std::merge( a, a + na, b, b + nb, out );
+            return;
+        }
+
+        simd_type lo = loadu< int32_t, TAG_T >( a );
+        simd_type hi = loadu< int32_t, TAG_T >( b );
+        size_t i = array_size;
+        size_t j = array_size;
+        while( true )
+        {
+            bitonic_merge< int32_t, TAG_T >( lo, hi );
+            storeu< int32_t, TAG_T >( out, lo );
+            out += array_size;
+
+            if( i + array_size > na || j + array_size > nb )
+                break;
+
+            bool take_a = a[ i ] <= b[ j ];
+            lo = loadu< int32_t, TAG_T >( take_a ? a + i : b + j );
+            i += take_a ? array_size : 0;
+            j += take_a ? 0 : array_size;
+        }
+
+        // The pending values and the input with less than a register left go into the other one
+        int32_t pending[ array_size ];
+        int32_t rest[ 2 * array_size ];
+        storeu< int32_t, TAG_T >( pending, hi );
+        if( i + array_size > na )
+        {
+            size_t count = std::merge( pending, pending + array_size, a + i, a + na, rest ) - rest;
+            insert_merge< false >( rest, count, b + j, nb - j, out );
+        }
+        else
+        {
+            size_t count = std::merge( pending, pending + array_size, b + j, b + nb, rest ) - rest;
+            insert_merge< true >( rest, count, a + i, na - i, out );
+        }
+    }
+
+    // Split of the first diagonal output values, a[0, first) and b[0, diagonal - first)
+    static size_t merge_path( const int32_t* a, size_t na, const int32_t* b, size_t nb, size_t diagonal )
+    {
+        size_t lo = (diagonal > nb) ? diagonal - nb : 0;
+        size_t hi = std::min( diagonal, na );
+        while( lo < hi )
+        {
+            size_t mid = lo + (hi - lo) / 2;
+            if( a[ mid ] <= b[ diagonal - mid - 1 ] )
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        return lo;
+    }
+
+private:
+    // Each small value goes before the first value of large that is not smaller, or when small
+    // stands for b (Small_B_T) before the first larger one. Registers of large below the next
+    // small value are copied whole, the one where it belongs is split with a compare mask.
+    template< bool Small_B_T >
+    static void insert_merge( const int32_t* small, size_t ns, const int32_t* large, size_t nl, int32_t* out )
+    {
+        const int32_t* pos = large;
+        const int32_t* end = large + nl;
+        for( size_t i = 0; i < ns; ++i )
+        {
+            int32_t key = small[ i ];
+            for( ; pos + array_size <= end && before< Small_B_T >( pos[ array_size - 1 ], key ); pos += array_size )
+            {
+                storeu< int32_t, TAG_T >( out, loadu< int32_t, TAG_T >( pos ) );
+                out += array_size;
+            }
+
+            size_t count = 0;
+            if( pos + array_size <= end )
+            {
+                simd_type val = loadu< int32_t, TAG_T >( pos );
+                count = Small_B_T
+                    ? array_size - mask_to_count< int32_t, TAG_T >( less_than_mask< int32_t, TAG_T >( key, val ) )
+                    : mask_to_count< int32_t, TAG_T >( greater_than_mask< int32_t, TAG_T >( key, val ) );
+                storeu< int32_t, TAG_T >( out, val );
+            }
+            else
+            {
+                while( pos + count < end && before< Small_B_T >( pos[ count ], key ) ) ++count;
+                std::copy( pos, pos + count, out );
+            }
+            pos += count;
+            out += count;
+            *out++ = key;
+        }
+        std::copy( pos, end, out );
+    }
+
+    // A value of large comes before key
+    template< bool Small_B_T >
+    static bool before( int32_t value, int32_t key )
+    {
+        return Small_B_T ? value <= key : value < key;
+    }
+};
+
+// Merges the sorted inputs into out. With more than one thread the output is cut in equal
+// parts and each part finds its inputs with merge_path
+template< typename TAG_T >
+void merge( const aligned_vector< int32_t >& a, const aligned_vector< int32_t >& b,
+            aligned_vector< int32_t >& out, size_t threads = 1 )
+{
+    out.resize( a.size() + b.size() );
+    reduce::run_parts( out.size(), threads, [&]( size_t, size_t first, size_t count )
+    {
+        size_t ai = merger< TAG_T >::merge_path( a.data(), a.size(), b.data(), b.size(), first );
+        size_t ae = merger< TAG_T >::merge_path( a.data(), a.size(), b.data(), b.size(), first + count );
+        merger< TAG_T >::merge( a.data() + ai, ae - ai, b.data() + first - ai,
+                                count - (ae - ai), out.data() + first );
+    } );
+}
+
+} // namespace simd_algorithms
+
+#endif // SIMD_ALGORITHMS_MERGE_H
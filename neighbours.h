@@ -0,0 +1,77 @@
+// MIT License
+//
+// Copyright (c) 2018 André Tupinambá
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef SIMD_ALGORITHMS_NEIGHBOURS_H
+#define SIMD_ALGORITHMS_NEIGHBOURS_H
+
+#include <iterator>
+#include <type_traits>
+
+namespace simd_algorithms{
+namespace neighbours{
+
+// Neighbour queries of a sorted range, built on the first value not less than key that an index
+// descent already found, so they cost no second search. The index passes that lower bound with
+// the begin and end of its container.
+
+// hi - lo for lo <= hi. Integers subtract in the unsigned type of the same width, where the
+// difference of any two values fits.
+template< typename Value_T >
+typename std::enable_if< std::is_integral< Value_T >::value, typename std::make_unsigned< Value_T >::type >::type
+gap( const Value_T& lo, const Value_T& hi )
+{
+    using unsigned_type = typename std::make_unsigned< Value_T >::type;
+    return static_cast< unsigned_type >( static_cast< unsigned_type >( hi ) - static_cast< unsigned_type >( lo ) );
+}
+
+template< typename Value_T >
+typename std::enable_if< !std::is_integral< Value_T >::value, Value_T >::type
+gap( const Value_T& lo, const Value_T& hi )
+{
+    return hi - lo;
+}
+
+// Largest value not greater than key, end when every value is greater. It is the lower bound
+// itself or the value just before it.
+template< class Iterator_T, typename Value_T >
+Iterator_T predecessor( Iterator_T lower, Iterator_T begin, Iterator_T end, const Value_T& key )
+{
+    if( lower != end && !(key < *lower) )
+        return lower;
+    return (lower == begin) ? end : std::prev( lower );
+}
+
+// Closest value to key, the smaller one on ties, end when the range is empty
+template< class Iterator_T, typename Value_T >
+Iterator_T nearest( Iterator_T lower, Iterator_T begin, Iterator_T end, const Value_T& key )
+{
+    if( lower == begin )
+        return lower;
+    auto prev = std::prev( lower );
+    if( lower == end )
+        return prev;
+    return (gap< Value_T >( key, *lower ) < gap< Value_T >( *prev, key )) ? lower : prev;
+}
+
+}} // namespace simd_algorithms::neighbours
+
+#endif // SIMD_ALGORITHMS_NEIGHBOURS_H
@@ -21,12 +21,16 @@
 // SOFTWARE.
 
 #include "nway_tree.h"
+#include "string_index.h"
+#include "../hash_map/hash_map.h"
 
 #include <iostream>
 #include <iomanip>
 #include <algorithm>
 #include <numeric>
 #include <map>
+#include <array>
+#include <cstring>
 #include <boost/timer/timer.hpp>
 
 bool g_verbose = true;
@@ -79,6 +83,35 @@ private:
     std::map< value_type, const_iterator > index_;
 };
 
+template< class Cont_T, typename TAG_T >
+struct hash_index
+{
+	using container_type = Cont_T;
+    using value_type     = typename container_type::value_type;
+    using const_iterator = typename container_type::const_iterator;
+
+    hash_index( const container_type& ref ) : ref_( ref ){}
+
+    void build_index()
+    {
+        index_.reserve( ref_.size() );
+        for( size_t i = 0; i < ref_.size(); ++i )
+        {
+            index_.insert( std::make_pair( ref_[i], i ) );
+        }
+    }
+
+    const_iterator find( const value_type& key )
+    {
+        auto it = index_.find( key );
+        return (it != index_.end()) ? ref_.begin() + it->second : ref_.end() ;
+    }
+
+private:
+    const container_type& ref_;
+    simd_algorithms::hash_map< value_type, size_t, TAG_T > index_;
+};
+
 void do_nothing( int32_t );
 
 template< class Cont_T, template < typename... > class Index_T, typename TAG_T >
@@ -134,6 +167,71 @@ uint64_t bench( const std::string& name, size_t size, size_t loop )
 }
 
 namespace sa = simd_algorithms;
+
+// 16 byte symbols, the first 6 bytes are shared by runs of keys
+using symbol_type = std::array< char, 16 >;
+using symbol_container = sa::aligned_vector< symbol_type >;
+
+struct symbol_less
+{
+    bool operator()( const symbol_type& lhs, const symbol_type& rhs ) const
+    {
+        return std::memcmp( lhs.data(), rhs.data(), lhs.size() ) < 0;
+    }
+};
+
+template< typename TAG_T >
+struct symbol_index
+{
+    symbol_index( const symbol_container& ref ) : index_( ref ){ index_.build_index(); }
+    symbol_container::const_iterator find( const symbol_type& key ) const { return index_.find( key ); }
+    sa::nway_tree::string_index< symbol_container, TAG_T > index_;
+};
+
+struct symbol_lower_bound
+{
+    symbol_lower_bound( const symbol_container& ref ) : ref_( ref ){}
+    symbol_container::const_iterator find( const symbol_type& key ) const
+    {
+        return std::lower_bound( ref_.begin(), ref_.end(), key, symbol_less() );
+    }
+    const symbol_container& ref_;
+};
+
+template< class Index_T >
+uint64_t bench_symbols( const std::string& name, size_t size, size_t loop )
+{
+    boost::timer::cpu_timer timer;
+    symbol_container org;
+    srand( 1 );
+    std::generate_n( std::back_inserter( org ), size, [](){
+        // Formatted in a larger buffer, the compiler cannot tell the 15 characters fit
+        char text[ 32 ];
+        snprintf( text, sizeof( text ), "SYM%03u%09u", static_cast< unsigned >( rand() % 1000 ),
+                  static_cast< unsigned >( rand() % 1000000000 ) );
+        symbol_type sym;
+        std::memcpy( sym.data(), text, sym.size() );
+        return sym;
+    } );
+    symbol_container sorted( org );
+    std::sort( sorted.begin(), sorted.end(), symbol_less() );
+    Index_T index( sorted );
+
+    timer.start();
+    for( size_t j = 0; j < loop; ++j )
+    {
+        for( auto& sym : org )
+        {
+            do_nothing( index.find( sym )->front() );
+        }
+    }
+    timer.stop();
+    if( g_verbose )
+        std::cout << "Find all " << name << ": " << timer.format();
+
+    return timer.elapsed().wall;
+}
+
 int main(int argc, char* /*argv*/[])
 {
     constexpr size_t runSize = 0x00400000;
@@ -167,6 +265,13 @@ int main(int argc, char* /*argv*/[])
             bench< sa::aligned_vector< int32_t >, map_index,
                    sa::sse_tag >( "std::map ....", runSize, loop );
 
+            uint64_t hash = bench< sa::aligned_vector< int32_t >, hash_index,
+                                 sa::avx_tag >( "hash_map AVX ", runSize, loop );
+
+            uint64_t symbols = bench_symbols< symbol_lower_bound >( "symbols lower_bound .", runSize / 4, loop );
+            uint64_t symbolsSse = bench_symbols< symbol_index< sa::sse_tag > >( "symbols index SSE ...", runSize / 4, loop );
+            uint64_t symbolsAvx = bench_symbols< symbol_index< sa::avx_tag > >( "symbols index AVX ...", runSize / 4, loop );
+
             std::cout
                       << std::endl << "Index Speed up SSE.......: " << std::fixed << std::setprecision(2)
                       << static_cast<float>(base)/static_cast<float>(index1) << "x"
@@ -174,6 +279,15 @@ int main(int argc, char* /*argv*/[])
                       << std::endl << "Index Speed up AVX.......: " << std::fixed << std::setprecision(2)
                       << static_cast<float>(base)/static_cast<float>(index2) << "x"
 
+                      << std::endl << "Hash Speed up AVX........: " << std::fixed << std::setprecision(2)
+                      << static_cast<float>(base)/static_cast<float>(hash) << "x"
+
+                      << std::endl << "Symbols Speed up SSE.....: " << std::fixed << std::setprecision(2)
+                      << static_cast<float>(symbols)/static_cast<float>(symbolsSse) << "x"
+
+                      << std::endl << "Symbols Speed up AVX.....: " << std::fixed << std::setprecision(2)
+                      << static_cast<float>(symbols)/static_cast<float>(symbolsAvx) << "x"
+
                       << std::endl << std::endl;
         }
         else
@@ -0,0 +1,175 @@
+// MIT License
+//
+// Copyright (c) 2018 André Tupinambá
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef SIMD_ALGORITHMS_NWAY_TREE_COMPOSITE_INDEX_H
+#define SIMD_ALGORITHMS_NWAY_TREE_COMPOSITE_INDEX_H
+
+#include <limits>
+#include "../simd_compare.h"
+
+namespace simd_algorithms{
+namespace nway_tree{
+
+// nway_tree over (major, minor) keys kept in two columns sorted together, major first. Every
+// level stores the separator columns apart as well, so a node compare is one
+// composite_greater_than_mask over a full register of each column, no packing of the pairs.
+// Positions are returned as indexes in the columns, size() when there is none.
+template< class Cont_T, typename TAG_T >
+class composite_index
+{
+public:
+	using container_type = Cont_T;
+    using value_type     = typename container_type::value_type;
+
+    composite_index( const container_type& major, const container_type& minor )
+        : major_( major ), minor_( minor ){}
+
+    void build_index()
+    {
+        tree_.clear();
+        if( major_.empty() )
+            return;
+
+        // One separator per leaf register, the last partial one included
+        tree_level leaves;
+        for( size_t i = array_size-1; i < size(); i += array_size )
+        {
+            leaves.push_back( major_[ i ], minor_[ i ] );
+        }
+        if( size() % array_size != 0 )
+        {
+            leaves.push_back( major_.back(), minor_.back() );
+        }
+        build_index( std::move( leaves ) );
+    }
+
+    size_t size() const
+    {
+        return major_.size();
+    }
+
+    // Position of the first row equal to (major, minor), size() when there is none
+    size_t find( value_type major, value_type minor ) const
+    {
+        size_t pos = lower_bound( major, minor );
+        return (pos < size() && major_[ pos ] == major && minor_[ pos ] == minor) ? pos : size();
+    }
+
+    // Position of the first row not less than (major, minor), size() when every row is less
+    size_t lower_bound( value_type major, value_type minor ) const
+    {
+        if( size() == 0 || less( size() - 1, major, minor ) )
+            return size();
+
+        size_t idx = 0;
+        for( auto&& level : tree_ )
+        {
+            uint32_t li = mask_to_index< value_type, TAG_T >( composite_greater_than_mask< value_type, TAG_T >(
+                              major, minor, *level.majors( idx ), *level.minors( idx ) ) );
+            idx = idx * array_size + li;
+        }
+
+        size_t pos = idx * array_size;
+        if( pos + array_size <= size() )
+        {
+            return pos + mask_to_index< value_type, TAG_T >( composite_greater_than_mask< value_type, TAG_T >(
+                             major, minor, *reinterpret_cast< const simd_type* >( &major_[ pos ] ),
+                             *reinterpret_cast< const simd_type* >( &minor_[ pos ] ) ) );
+        }
+        while( pos < size() && less( pos, major, minor ) )
+        {
+            ++pos;
+        }
+        return pos;
+    }
+
+private:
+    constexpr static size_t array_size = traits< value_type, TAG_T >::simd_size;
+    using simd_type = typename traits< value_type, TAG_T >::simd_type;
+
+    struct tree_level
+    {
+        aligned_vector< value_type > major_keys_;
+        aligned_vector< value_type > minor_keys_;
+
+        const simd_type* majors( size_t idx ) const
+        {
+            return reinterpret_cast< const simd_type* >( &major_keys_[ idx * array_size ] );
+        }
+
+        const simd_type* minors( size_t idx ) const
+        {
+            return reinterpret_cast< const simd_type* >( &minor_keys_[ idx * array_size ] );
+        }
+
+        size_t size() const
+        {
+            return major_keys_.size();
+        }
+
+        void push_back( value_type major, value_type minor )
+        {
+            major_keys_.push_back( major );
+            minor_keys_.push_back( minor );
+        }
+
+        void adjust()
+        {
+            size_t size = (major_keys_.size() + array_size - 1) / array_size * array_size;
+            major_keys_.resize( size, std::numeric_limits< value_type >::max() );
+            minor_keys_.resize( size, std::numeric_limits< value_type >::max() );
+        }
+    };
+
+    aligned_vector< tree_level > tree_;
+    const container_type& major_;
+    const container_type& minor_;
+
+    bool less( size_t pos, value_type major, value_type minor ) const
+    {
+        return major_[ pos ] < major || (major_[ pos ] == major && minor_[ pos ] < minor);
+    }
+
+    void build_index( tree_level&& keys )
+    {
+        if( keys.size() > array_size )
+        {
+            tree_level upper;
+            for( size_t i = array_size-1; i < keys.size(); i += array_size )
+            {
+                upper.push_back( keys.major_keys_[ i ], keys.minor_keys_[ i ] );
+            }
+            if( keys.size() % array_size != 0 )
+            {
+                upper.push_back( keys.major_keys_.back(), keys.minor_keys_.back() );
+            }
+            build_index( std::move( upper ) );
+        }
+
+        keys.adjust();
+        tree_.emplace_back( std::move( keys ) );
+    }
+};
+
+}} // namespace simd_algoriths::nway_tree
+
+#endif // SIMD_ALGORITHMS_NWAY_TREE_COMPOSITE_INDEX_H
@@ -23,11 +23,14 @@
 #ifndef SIMD_ALGORITHMS_NWAY_TREE_H
 #define SIMD_ALGORITHMS_NWAY_TREE_H
 
+#include <algorithm>
 #include <iostream>
 #include <iomanip>
+#include <utility>
 #include "../simd_compare.h"
+#include "../neighbours.h"
 
-std::ostream& operator<<( std::ostream& out, __m128i val )
+inline std::ostream& operator<<( std::ostream& out, __m128i val )
 {
     uint32_t* pval = reinterpret_cast<uint32_t*>( &val );
     out << std::hex << "("
@@ -38,7 +41,7 @@ std::ostream& operator<<( std::ostream& out, __m128i val )
     return out;
 }
 
-std::ostream& operator<<( std::ostream& out, __m256i val )
+inline std::ostream& operator<<( std::ostream& out, __m256i val )
 {
     uint32_t* pval = reinterpret_cast<uint32_t*>( &val );
     out << std::hex << "("
@@ -84,6 +87,15 @@ public:
 
     const_iterator find( const value_type& key ) const
     {
+        // The levels cover the full registers only, keys past them are in the last values or
+        // not found
+        size_t full = ref_.size() / array_size * array_size;
+        if( full == 0 || ref_[ full - 1 ] < key )
+        {
+            auto first = std::lower_bound( ref_.begin() + full, ref_.end(), key );
+            return (first != ref_.end() && !(key < *first)) ? first : ref_.end();
+        }
+
         size_t idx = 0;
         for( auto&& level : tree_ )
         {
@@ -104,6 +116,67 @@ public:
         return it;
     }
 
+    // First value not less than key, end() when every value is less
+    const_iterator lower_bound( const value_type& key ) const
+    {
+        size_t full = ref_.size() / array_size * array_size;
+        if( full == 0 || ref_[ full - 1 ] < key )
+        {
+            return std::lower_bound( ref_.begin() + full, ref_.end(), key );
+        }
+
+        size_t idx = 0;
+        for( auto&& level : tree_ )
+        {
+            uint32_t li = greater_than_index< value_type, TAG_T >( key, *level.get_simd( idx ) );
+            idx = idx * array_size + li;
+        }
+
+        // The descent ends on the register whose last value is the first one not less than key
+        const simd_type* cmp = reinterpret_cast< const simd_type* >( &ref_[ idx * array_size ] );
+        auto it = ref_.begin();
+        std::advance( it, idx * array_size + greater_than_index< value_type, TAG_T >( key, *cmp ) );
+        return it;
+    }
+
+    // Smallest value not less than key, end() when every value is less
+    const_iterator successor( const value_type& key ) const
+    {
+        return lower_bound( key );
+    }
+
+    // Largest value not greater than key, end() when every value is greater
+    const_iterator predecessor( const value_type& key ) const
+    {
+        return neighbours::predecessor( lower_bound( key ), ref_.begin(), ref_.end(), key );
+    }
+
+    // Closest value to key, the smaller one on ties, end() when the container is empty
+    const_iterator nearest( const value_type& key ) const
+    {
+        return neighbours::nearest( lower_bound( key ), ref_.begin(), ref_.end(), key );
+    }
+
+    // Values in [lo, hi), one descent to lo then whole registers until one has values past hi
+    std::pair< const_iterator, const_iterator > range( const value_type& lo, const value_type& hi ) const
+    {
+        auto first = lower_bound( lo );
+        return std::make_pair( first, std::next( first, scan_range( first, hi, []( const_iterator, size_t ){} ) ) );
+    }
+
+    size_t count( const value_type& lo, const value_type& hi ) const
+    {
+        return scan_range( lower_bound( lo ), hi, []( const_iterator, size_t ){} );
+    }
+
+    // Calls block_fn( first, count ) for each run of values in [lo, hi), at most one register
+    // long, as soon as the register is compared
+    template< class Fn_T >
+    size_t range( const value_type& lo, const value_type& hi, Fn_T block_fn ) const
+    {
+        return scan_range( lower_bound( lo ), hi, block_fn );
+    }
+
 private:
     constexpr static size_t array_size = traits< value_type, TAG_T >::simd_size;
     using simd_type = typename traits< value_type, TAG_T >::simd_type;
@@ -130,7 +203,40 @@ private:
     aligned_vector< tree_level > tree_;
     const container_type& ref_;
 
-    void build_index( const container_type& cont )
+    // The number of values from first on that are less than hi. Each register adds its count of
+    // values less than hi, a register with fewer than array_size of them ends the range.
+    template< class Fn_T >
+    size_t scan_range( const_iterator first, const value_type& hi, Fn_T&& block_fn ) const
+    {
+        size_t start = std::distance( ref_.begin(), first );
+        size_t full = ref_.size() / array_size * array_size;
+        size_t pos = start;
+        for( size_t base = start / array_size * array_size; base < full; base += array_size )
+        {
+            const simd_type* cmp = reinterpret_cast< const simd_type* >( &ref_[ base ] );
+            size_t less = mask_to_count< value_type, TAG_T >( greater_than_mask< value_type, TAG_T >( hi, *cmp ) );
+            if( base + less > pos )
+            {
+                block_fn( std::next( ref_.begin(), pos ), base + less - pos );
+                pos = base + less;
+            }
+            if( less < array_size )
+                return pos - start;
+        }
+
+        size_t end = pos;
+        while( end < ref_.size() && ref_[ end ] < hi )
+        {
+            ++end;
+        }
+        if( end > pos )
+        {
+            block_fn( std::next( ref_.begin(), pos ), end - pos );
+        }
+        return end - start;
+    }
+
+    void build_index( const container_type& cont, bool partial = false )
     {
         if( cont.size() <= array_size )
             return;
@@ -141,7 +247,14 @@ private:
             level.keys_.push_back( cont[ i ] );
         }
 
-        build_index( level.keys_ );
+        // The inner levels are padded, so their last partial register needs a separator too or
+        // the keys above the last full one would descend past the end of the level
+        if( partial && cont.size() % array_size != 0 )
+        {
+            level.keys_.push_back( cont.back() );
+        }
+
+        build_index( level.keys_, true );
 
         level.adjust();
         tree_.emplace_back( std::move( level ) );
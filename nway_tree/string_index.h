@@ -0,0 +1,187 @@
+// MIT License
+//
+// Copyright (c) 2018 André Tupinambá
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef SIMD_ALGORITHMS_NWAY_TREE_STRING_INDEX_H
+#define SIMD_ALGORITHMS_NWAY_TREE_STRING_INDEX_H
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <tuple>
+#include "../simd_compare.h"
+
+namespace simd_algorithms{
+namespace nway_tree{
+
+// nway_tree for fixed length string keys, value_type is std::array< char, N > sorted in memcmp
+// order. The tree levels hold the first sizeof(Prefix_T) bytes of the keys as big endian
+// integers (int32_t or int64_t), searched with greater_than_index like the integer tree. Keys
+// sharing a prefix are told apart in the leaves with compare_bytes over the full key.
+template< class Cont_T, typename TAG_T, typename Prefix_T = int64_t >
+class string_index
+{
+public:
+	using container_type = Cont_T;
+    using value_type     = typename container_type::value_type;
+    using const_iterator = typename container_type::const_iterator;
+
+    enum : size_t { key_size = std::tuple_size< value_type >::value };
+
+    string_index( const container_type& ref )
+        : ref_( ref ){}
+
+    void build_index()
+    {
+        tree_.clear();
+        if( ref_.empty() )
+            return;
+
+        // One separator per leaf register worth of keys, the last partial one included
+        aligned_vector< Prefix_T > leaves;
+        for( size_t i = array_size-1; i < ref_.size(); i += array_size )
+        {
+            leaves.push_back( prefix( ref_[ i ] ) );
+        }
+        if( ref_.size() % array_size != 0 )
+        {
+            leaves.push_back( prefix( ref_.back() ) );
+        }
+        build_index( leaves );
+    }
+
+    const_iterator find( const value_type& key ) const
+    {
+        auto first = lower_bound( key );
+        return (first != ref_.end() && compare( *first, key ) == 0) ? first : ref_.end();
+    }
+
+    // First key not less than key, end() when every key is less
+    const_iterator lower_bound( const value_type& key ) const
+    {
+        Prefix_T kp = prefix( key );
+        if( ref_.empty() || prefix( ref_.back() ) < kp )
+            return ref_.end();
+
+        size_t idx = 0;
+        for( auto&& level : tree_ )
+        {
+            uint32_t li = greater_than_index< Prefix_T, TAG_T >( kp, *level.get_simd( idx ) );
+            idx = idx * array_size + li;
+        }
+
+        // Every key before the leaf has a smaller prefix. The keys with the same prefix as key
+        // may go past the leaf, they are galloped over.
+        size_t pos = std::min( idx * array_size, ref_.size() );
+        size_t last = std::min( pos + array_size, ref_.size() );
+        while( pos < last && compare( ref_[ pos ], key ) < 0 )
+        {
+            ++pos;
+        }
+        if( pos < last || pos == ref_.size() || prefix( ref_[ pos ] ) != kp )
+            return std::next( ref_.begin(), pos );
+
+        size_t step = 1;
+        size_t hi = pos;
+        while( hi < ref_.size() && compare( ref_[ hi ], key ) < 0 )
+        {
+            pos = hi + 1;
+            hi += step;
+            step *= 2;
+        }
+        hi = std::min( hi, ref_.size() );
+        return std::lower_bound( std::next( ref_.begin(), pos ), std::next( ref_.begin(), hi ), key,
+                                 []( const value_type& lhs, const value_type& rhs ){ return compare( lhs, rhs ) < 0; } );
+    }
+
+    // Big endian first bytes with the sign bit flipped, so the signed compare follows memcmp
+    static Prefix_T prefix( const value_type& key )
+    {
+        typename std::make_unsigned< Prefix_T >::type raw = 0;
+        std::memcpy( &raw, key.data(), std::min< size_t >( key_size, sizeof( Prefix_T ) ) );
+        raw = byte_swap( raw ) ^ (decltype( raw )( 1 ) << (8 * sizeof( Prefix_T ) - 1));
+        return static_cast< Prefix_T >( raw );
+    }
+
+private:
+    constexpr static size_t array_size = traits< Prefix_T, TAG_T >::simd_size;
+    using simd_type = typename traits< Prefix_T, TAG_T >::simd_type;
+
+    struct tree_level
+    {
+        aligned_vector< Prefix_T > keys_;
+
+        const simd_type* get_simd( size_t idx ) const
+        {
+            return reinterpret_cast< const simd_type* >( &keys_[ idx * array_size ] );
+        }
+
+        void adjust()
+        {
+            size_t size = (keys_.size() + array_size - 1) / array_size * array_size;
+            keys_.resize( size, std::numeric_limits< Prefix_T >::max() );
+        }
+    };
+
+    aligned_vector< tree_level > tree_;
+    const container_type& ref_;
+
+    static int compare( const value_type& lhs, const value_type& rhs )
+    {
+        return compare_bytes< TAG_T >( lhs.data(), rhs.data(), key_size );
+    }
+
+    static uint32_t byte_swap( uint32_t val )
+    {
+        return __builtin_bswap32( val );
+    }
+
+    static uint64_t byte_swap( uint64_t val )
+    {
+        return __builtin_bswap64( val );
+    }
+
+    void build_index( const aligned_vector< Prefix_T >& keys )
+    {
+        if( keys.size() > array_size )
+        {
+            aligned_vector< Prefix_T > upper;
+            for( size_t i = array_size-1; i < keys.size(); i += array_size )
+            {
+                upper.push_back( keys[ i ] );
+            }
+            if( keys.size() % array_size != 0 )
+            {
+                upper.push_back( keys.back() );
+            }
+            build_index( upper );
+        }
+
+        tree_level level;
+        level.keys_ = keys;
+        level.adjust();
+        tree_.emplace_back( std::move( level ) );
+    }
+};
+
+}} // namespace simd_algoriths::nway_tree
+
+#endif // SIMD_ALGORITHMS_NWAY_TREE_STRING_INDEX_H
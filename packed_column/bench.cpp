@@ -0,0 +1,138 @@
+// MIT License
+//
+// Copyright (c) 2018 André Tupinambá
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "packed_column.h"
+#include "../nway_tree/nway_tree.h"
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <boost/timer/timer.hpp>
+
+bool g_verbose = true;
+namespace sa = simd_algorithms;
+
+void do_nothing( int32_t );
+
+using container_type = sa::aligned_vector< int32_t >;
+
+template< typename TAG_T >
+uint64_t bench_nway( const std::string& name, const container_type& sorted, const container_type& keys, size_t loop )
+{
+    boost::timer::cpu_timer timer;
+    sa::nway_tree::index< container_type, TAG_T > index( sorted );
+    index.build_index();
+
+    timer.start();
+    for( size_t j = 0; j < loop; ++j )
+    {
+        for( auto key : keys )
+        {
+            auto ret = index.find( key );
+            do_nothing( (ret != sorted.end()) ? *ret : 0 );
+        }
+    }
+    timer.stop();
+    if( g_verbose )
+        std::cout << "Find " << name << ": " << timer.format();
+
+    return timer.elapsed().wall;
+}
+
+template< typename TAG_T >
+uint64_t bench_packed( const std::string& name, const container_type& sorted, const container_type& keys, size_t loop )
+{
+    boost::timer::cpu_timer timer;
+    sa::packed_column< TAG_T > column( sorted );
+
+    timer.start();
+    for( size_t j = 0; j < loop; ++j )
+    {
+        for( auto key : keys )
+        {
+            do_nothing( static_cast< int32_t >( column.find( key ) ) );
+        }
+    }
+    timer.stop();
+    if( g_verbose )
+        std::cout << "Find " << name << ": " << timer.format();
+
+    return timer.elapsed().wall;
+}
+
+int main(int argc, char* /*argv*/[])
+{
+    constexpr size_t runSize = 0x00400000;
+    constexpr size_t loop = 4;
+    if( argc > 1 )
+    {
+        g_verbose = false;
+        std::cout << "count,nway avx,packed avx,nway sse,packed sse" << std::endl;
+    }
+    else
+    {
+        std::cout << "\nsize: 0x" << std::hex << std::setw(8) << std::setfill( '0') << runSize << std::endl << std::endl;
+    }
+
+    srand( 1 );
+    container_type sorted;
+    std::generate_n( std::back_inserter( sorted ), runSize, rand );
+    std::sort( sorted.begin(), sorted.end() );
+    container_type keys;
+    std::generate_n( std::back_inserter( keys ), runSize, [&](){ return sorted[ rand() % runSize ]; } );
+
+    size_t cnt = 0;
+    while( 1 )
+    {
+        uint64_t nway = bench_nway< sa::avx_tag >( "nway AVX ....", sorted, keys, loop );
+        uint64_t packed = bench_packed< sa::avx_tag >( "packed AVX ..", sorted, keys, loop );
+        uint64_t nwaySse = bench_nway< sa::sse_tag >( "nway SSE ....", sorted, keys, loop );
+        uint64_t packedSse = bench_packed< sa::sse_tag >( "packed SSE ..", sorted, keys, loop );
+
+        if( g_verbose )
+        {
+            std::cout
+                      << std::endl << "Packed bytes per key: " << std::fixed << std::setprecision(2)
+                      << static_cast<float>( sa::packed_column< sa::avx_tag >( sorted ).memory_size() ) / sorted.size()
+                      << " (unpacked " << sizeof( int32_t ) << ")"
+
+                      << std::endl << "Speed up AVX........: " << std::fixed << std::setprecision(2)
+                      << static_cast<float>(nway)/static_cast<float>(packed) << "x"
+
+                      << std::endl << "Speed up SSE........: " << std::fixed << std::setprecision(2)
+                      << static_cast<float>(nwaySse)/static_cast<float>(packedSse) << "x"
+
+                      << std::endl << std::endl;
+        }
+        else
+        {
+            std::cout
+                << ++cnt << ","
+                << nway << ","
+                << packed << ","
+                << nwaySse << ","
+                << packedSse
+                << std::endl;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,253 @@
+// MIT License
+//
+// Copyright (c) 2018 André Tupinambá
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef SIMD_ALGORITHMS_PACKED_COLUMN_H
+#define SIMD_ALGORITHMS_PACKED_COLUMN_H
+
+#include <algorithm>
+#include "../simd_compare.h"
+#include "../nway_tree/nway_tree.h"
+
+namespace simd_algorithms{
+
+// Sorted int32 column stored with frame of reference bit packing. Every block of block_size
+// values keeps its first value as base and the others as bits wide offsets from it. The offsets
+// are packed vertically: value j of the block goes to lane j % array_size, so each register of
+// packed words unpacks to array_size consecutive values with one shift, or and and.
+//
+// Only the block maxima are kept uncompressed, searched by an nway_tree, so find decompresses a
+// single block.
+template< typename TAG_T >
+class packed_column
+{
+public:
+    using value_type = int32_t;
+    using simd_type  = typename traits< int32_t, TAG_T >::simd_type;
+    constexpr static size_t array_size = traits< int32_t, TAG_T >::simd_size;
+
+    enum : size_t { block_size = 128, rows = block_size / array_size, npos = ~size_t( 0 ) };
+
+    template< class Cont_T >
+    explicit packed_column( const Cont_T& sorted )
+        : size_( sorted.size() ), top_( maxima_ )
+    {
+        for( size_t first = 0; first < size_; first += block_size )
+        {
+            pack_block( sorted, first );
+        }
+        top_.build_index();
+    }
+
+    // The tree keeps a reference to maxima_
+    packed_column( const packed_column& ) = delete;
+    packed_column& operator=( const packed_column& ) = delete;
+
+    size_t size() const
+    {
+        return size_;
+    }
+
+    // Bytes used by the packed words, block headers and maxima. The tree levels over the maxima
+    // add about a further 1/(array_size-1) of the maxima.
+    size_t memory_size() const
+    {
+        return words_.size() * sizeof( int32_t )
+             + headers_.size() * sizeof( block_header )
+             + maxima_.size() * sizeof( value_type );
+    }
+
+    value_type operator[]( size_t pos ) const
+    {
+        const block_header& head = headers_[ pos / block_size ];
+        if( head.bits == 0 )
+            return head.base;
+
+        size_t row  = (pos % block_size) / array_size;
+        size_t lane = pos % array_size;
+        size_t bit  = row * head.bits;
+        const int32_t* words = &words_[ head.offset * array_size + lane ];
+
+        uint64_t packed = static_cast< uint32_t >( words[ (bit / 32) * array_size ] );
+        if( bit % 32 + head.bits > 32 )
+        {
+            packed |= static_cast< uint64_t >( static_cast< uint32_t >( words[ (bit / 32 + 1) * array_size ] ) ) << 32;
+        }
+        uint32_t offset = static_cast< uint32_t >( packed >> (bit % 32) ) & low_bits( head.bits );
+        return static_cast< value_type >( static_cast< uint32_t >( head.base ) + offset );
+    }
+
+    // Unpacks the block_size values of a block, the last block is padded with its last value
+    void decode_block( size_t block, value_type* out ) const
+    {
+        const block_header& head = headers_[ block ];
+        simd_type base = broadcast< int32_t, TAG_T >( head.base );
+        unpack( head, [&]( size_t row, simd_type offsets )
+        {
+            storeu< int32_t, TAG_T >( out + row * array_size, add< int32_t, TAG_T >( offsets, base ) );
+            return false;
+        } );
+    }
+
+    // Position of the first value equal to key, npos if there is none
+    size_t find( value_type key ) const
+    {
+        size_t block = find_block( key );
+        if( block == headers_.size() )
+            return npos;
+
+        // The offsets are compared with key - base, no need to add the base back. Keys below the
+        // base wrap around past every offset.
+        const block_header& head = headers_[ block ];
+        int32_t target = static_cast< int32_t >( static_cast< uint32_t >( key ) - static_cast< uint32_t >( head.base ) );
+        size_t pos = npos;
+        unpack( head, [&]( size_t row, simd_type offsets )
+        {
+            uint32_t mask = equal_mask< int32_t, TAG_T >( target, offsets );
+            if( mask == 0 )
+                return false;
+            pos = block * block_size + row * array_size + _bit_scan_forward( mask ) / sizeof( int32_t );
+            return true;
+        } );
+        return pos;
+    }
+
+    // Position of the first value not less than key, size() when every value is less
+    size_t lower_bound( value_type key ) const
+    {
+        size_t block = find_block( key );
+        if( block == headers_.size() )
+            return size_;
+
+        alignas( 32 ) value_type values[ block_size ];
+        decode_block( block, values );
+        size_t pos = block * block_size + (std::lower_bound( values, values + block_size, key ) - values);
+        return std::min( pos, size_ );
+    }
+
+private:
+    struct block_header
+    {
+        value_type base;
+        uint32_t bits;
+        uint32_t offset; // First register of the block in words_
+    };
+
+    size_t size_;
+    aligned_vector< int32_t > words_;
+    aligned_vector< block_header > headers_;
+    aligned_vector< value_type > maxima_;
+    nway_tree::index< aligned_vector< value_type >, TAG_T > top_;
+
+    static uint32_t low_bits( uint32_t bits )
+    {
+        return (bits == 32) ? ~0u : (1u << bits) - 1;
+    }
+
+    static size_t register_count( uint32_t bits )
+    {
+        return (rows * bits + 31) / 32;
+    }
+
+    // First block whose maximum is not less than key
+    size_t find_block( value_type key ) const
+    {
+        return std::distance( maxima_.begin(), top_.lower_bound( key ) );
+    }
+
+    template< class Cont_T >
+    void pack_block( const Cont_T& sorted, size_t first )
+    {
+        size_t count = std::min< size_t >( block_size, size_ - first );
+        value_type base = sorted[ first ];
+        value_type last = sorted[ first + count - 1 ];
+        uint32_t range = static_cast< uint32_t >( last ) - static_cast< uint32_t >( base );
+
+        block_header head;
+        head.base = base;
+        head.bits = (range == 0) ? 0 : 32 - __builtin_clz( range );
+        head.offset = static_cast< uint32_t >( words_.size() / array_size );
+        headers_.push_back( head );
+        maxima_.push_back( last );
+
+        if( head.bits == 0 )
+            return;
+
+        size_t begin = words_.size();
+        words_.resize( begin + register_count( head.bits ) * array_size, 0 );
+        uint32_t* words = reinterpret_cast< uint32_t* >( &words_[ begin ] );
+        for( size_t j = 0; j < block_size; ++j )
+        {
+            value_type value = sorted[ first + std::min( j, count - 1 ) ];
+            uint32_t offset = static_cast< uint32_t >( value ) - static_cast< uint32_t >( base );
+            size_t bit  = (j / array_size) * head.bits;
+            size_t lane = j % array_size;
+            words[ (bit / 32) * array_size + lane ] |= offset << (bit % 32);
+            if( bit % 32 + head.bits > 32 )
+            {
+                words[ (bit / 32 + 1) * array_size + lane ] |= offset >> (32 - bit % 32);
+            }
+        }
+    }
+
+    // Calls row_fn( row, offsets ) for every row of the block until it returns true
+    template< class Fn_T >
+    void unpack( const block_header& head, Fn_T row_fn ) const
+    {
+        if( head.bits == 0 )
+        {
+            simd_type zero = broadcast< int32_t, TAG_T >( 0 );
+            for( size_t row = 0; row < rows; ++row )
+            {
+                if( row_fn( row, zero ) )
+                    return;
+            }
+            return;
+        }
+
+        const simd_type* in = reinterpret_cast< const simd_type* >( &words_[ head.offset * array_size ] );
+        simd_type mask = broadcast< int32_t, TAG_T >( static_cast< int32_t >( low_bits( head.bits ) ) );
+        simd_type cur = in[ 0 ];
+        int shift = 0;
+        for( size_t row = 0; row < rows; ++row )
+        {
+            simd_type offsets = shift_right< int32_t, TAG_T >( cur, shift );
+            shift += head.bits;
+            if( shift >= 32 )
+            {
+                // The offset continues on the next register, unless it ended right on the border
+                shift -= 32;
+                if( row + 1 < rows || shift != 0 )
+                {
+                    cur = *++in;
+                    if( shift != 0 )
+                        offsets = mask_or< TAG_T >( offsets, shift_left< int32_t, TAG_T >( cur, head.bits - shift ) );
+                }
+            }
+            if( row_fn( row, mask_and< TAG_T >( offsets, mask ) ) )
+                return;
+        }
+    }
+};
+
+} // namespace simd_algorithms
+
+#endif // SIMD_ALGORITHMS_PACKED_COLUMN_H
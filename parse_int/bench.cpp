@@ -0,0 +1,153 @@
+// MIT License
+//
+// Copyright (c) 2018 André Tupinambá
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "parse_int.h"
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <numeric>
+#include <cstdlib>
+#include <boost/timer/timer.hpp>
+
+bool g_verbose = true;
+namespace sa = simd_algorithms;
+
+void do_nothing( const sa::aligned_string& );
+void do_nothing( size_t );
+
+template< typename Value_T, typename TAG_T >
+struct strtol_parser
+{
+    size_t operator()( const sa::aligned_string& text, sa::aligned_vector< Value_T >& out )
+    {
+        const char* ptr = text.c_str();
+        const char* end = ptr + text.size();
+        while( ptr < end )
+        {
+            char* next;
+            long long val = strtoll( ptr, &next, 10 );
+            if( next == ptr )
+                break;
+            out.push_back( static_cast< Value_T >( val ) );
+            ptr = next;
+        }
+        return out.size();
+    }
+};
+
+template< typename Value_T, typename TAG_T >
+struct simd_parser
+{
+    size_t operator()( const sa::aligned_string& text, sa::aligned_vector< Value_T >& out )
+    {
+        return sa::string_algo::parse_int< Value_T, TAG_T >( text, out );
+    }
+};
+
+// One key per line, as written by a text dump of an index
+template< typename Value_T >
+sa::aligned_string make_dump( size_t count )
+{
+    sa::aligned_string ret;
+    srand(1);
+    for( size_t i = 0; i < count; ++i )
+    {
+        int64_t val = static_cast< int64_t >( rand() ) - RAND_MAX / 2;
+        if( sizeof(Value_T) == 8 )
+            val *= rand();
+        ret += std::to_string( val ).c_str();
+        ret += '\n';
+    }
+    return ret;
+}
+
+template< typename Value_T, template< typename, typename > class PARSER_T, typename TAG_T >
+uint64_t bench( const std::string& name, const sa::aligned_string& text, size_t loop )
+{
+    boost::timer::cpu_timer timer;
+    PARSER_T< Value_T, TAG_T > parser;
+
+    timer.start();
+    for( size_t j = 0; j < loop; ++j )
+    {
+        sa::aligned_vector< Value_T > out;
+        do_nothing( parser( text, out ) );
+    }
+    timer.stop();
+    if( g_verbose )
+        std::cout << "Parse " << name << ": " << timer.format();
+
+    return timer.elapsed().wall;
+}
+
+int main(int argc, char* /*argv*/[])
+{
+    constexpr size_t runSize = 0x00100000;
+    constexpr size_t loop = 20;
+    if( argc > 1 )
+    {
+        g_verbose = false;
+        std::cout << "count,base,sse,avx" << std::endl;
+    }
+    else
+    {
+        std::cout << "\nsize: 0x" << std::hex << std::setw(8) << std::setfill( '0') << runSize << std::endl << std::endl;
+    }
+
+    sa::aligned_string text32 = make_dump< int32_t >( runSize );
+    sa::aligned_string text64 = make_dump< int64_t >( runSize );
+    size_t cnt = 0;
+    while( 1 )
+    {
+        uint64_t base = bench< int32_t, strtol_parser, sa::sse_tag >( "strtol .", text32, loop );
+        uint64_t sse = bench< int32_t, simd_parser, sa::sse_tag >( "SSE ....", text32, loop );
+        uint64_t avx = bench< int32_t, simd_parser, sa::avx_tag >( "AVX ....", text32, loop );
+
+        if( g_verbose )
+        {
+            uint64_t base64 = bench< int64_t, strtol_parser, sa::sse_tag >( "strtol 64", text64, loop );
+            uint64_t avx64 = bench< int64_t, simd_parser, sa::avx_tag >( "AVX 64 ..", text64, loop );
+            std::cout
+                      << std::endl << "Speed up SSE.......: " << std::fixed << std::setprecision(2)
+                      << static_cast<float>(base)/static_cast<float>(sse) << "x"
+
+                      << std::endl << "Speed up AVX.......: " << std::fixed << std::setprecision(2)
+                      << static_cast<float>(base)/static_cast<float>(avx) << "x"
+
+                      << std::endl << "Speed up AVX 64....: " << std::fixed << std::setprecision(2)
+                      << static_cast<float>(base64)/static_cast<float>(avx64) << "x"
+
+                      << std::endl << std::endl;
+        }
+        else
+        {
+            std::cout
+                << ++cnt << ","
+                << base << ","
+                << sse << ","
+                << avx
+                << std::endl;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,167 @@
+// MIT License
+//
+// Copyright (c) 2018 André Tupinambá
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef SIMD_ALGORITHMS_PARSE_INT_H
+#define SIMD_ALGORITHMS_PARSE_INT_H
+
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <boost/utility/string_view.hpp>
+#include "../simd_compare.h"
+
+namespace simd_algorithms{
+namespace string_algo{
+
+// Decimal integer parser for text dumps. Every run of digits is a number, a '-' right before
+// it makes it negative and any other byte is a separator. Digit runs are found a register at a
+// time with a range compare and up to 16 digits are converted at once with multiply-add
+// chains (decimal_value). Numbers that do not fit Value_T throw std::out_of_range.
+template< typename Value_T, typename TAG_T >
+class int_parser
+{
+public:
+    static_assert( std::is_same< Value_T, int32_t >::value || std::is_same< Value_T, int64_t >::value,
+                   "int_parser parses int32_t or int64_t" );
+
+    using container_type = aligned_vector< Value_T >;
+    constexpr static size_t array_size = traits< char, TAG_T >::simd_size;
+
+    // Appends the numbers in text to out, returns how many
+    size_t operator()( boost::string_view text, container_type& out ) const
+    {
+        const char* data = text.data();
+        size_t size = text.size();
+        size_t count = out.size();
+
+        for( size_t pos = next_digit( data, 0, size ); pos < size; )
+        {
+            size_t end = digit_end( data, pos, size );
+            bool negative = pos > 0 && data[ pos - 1 ] == '-';
+            out.push_back( convert( data, pos, end, negative ) );
+            pos = next_digit( data, end, size );
+        }
+        return out.size() - count;
+    }
+
+private:
+    constexpr static uint32_t all_lanes = (array_size == 32) ? 0xffffffff : 0xffff;
+
+    static uint32_t digit_mask( const char* ptr )
+    {
+        return result_to_mask< char, TAG_T >( in_range< char, TAG_T >( loadu< char, TAG_T >( ptr ), '0', '9' ) );
+    }
+
+    static bool is_digit( char ch )
+    {
+        return '0' <= ch && ch <= '9';
+    }
+
+    static size_t next_digit( const char* data, size_t pos, size_t size )
+    {
+        for( ; pos + array_size <= size; pos += array_size )
+        {
+            uint32_t mask = digit_mask( data + pos );
+            if( mask != 0 )
+                return pos + _bit_scan_forward( mask );
+        }
+        while( pos < size && !is_digit( data[pos] ) )
+        {
+            ++pos;
+        }
+        return pos;
+    }
+
+    static size_t digit_end( const char* data, size_t pos, size_t size )
+    {
+        for( ; pos + array_size <= size; pos += array_size )
+        {
+            uint32_t mask = ~digit_mask( data + pos ) & all_lanes;
+            if( mask != 0 )
+                return pos + _bit_scan_forward( mask );
+        }
+        while( pos < size && is_digit( data[pos] ) )
+        {
+            ++pos;
+        }
+        return pos;
+    }
+
+    static Value_T convert( const char* data, size_t start, size_t end, bool negative )
+    {
+        uint64_t limit = static_cast< uint64_t >( std::numeric_limits< Value_T >::max() ) + negative;
+
+        size_t first = start;
+        while( end - first > 16 && data[ first ] == '0' )
+        {
+            ++first;
+        }
+
+        uint64_t value = 0;
+        size_t len = end - first;
+        if( len > 16 )
+        {
+            // Leading digits one by one, the last 16 at once
+            for( size_t i = first; i < end - 16; ++i )
+            {
+                value = value * 10 + (data[i] - '0');
+                if( value > limit / 10000000000000000ULL )
+                    overflow( data, start, end, negative );
+            }
+            value = value * 10000000000000000ULL + decimal_value( loadu< char, sse_tag >( data + end - 16 ), 16 );
+        }
+        else if( end >= 16 )
+        {
+            value = decimal_value( loadu< char, sse_tag >( data + end - 16 ), len );
+        }
+        else
+        {
+            // Too close to the start of the text to load the 16 bytes before end
+            char buffer[16] = {};
+            std::memcpy( buffer + 16 - len, data + first, len );
+            value = decimal_value( loadu< char, sse_tag >( buffer ), len );
+        }
+
+        if( value > limit )
+            overflow( data, start, end, negative );
+
+        return negative ? static_cast< Value_T >( -static_cast< int64_t >( value - 1 ) - 1 )
+                        : static_cast< Value_T >( value );
+    }
+
+    [[noreturn]] static void overflow( const char* data, size_t start, size_t end, bool negative )
+    {
+        throw std::out_of_range( "int_parser: " + std::string( data + start - negative, data + end ) );
+    }
+};
+
+template< typename Value_T, typename TAG_T >
+inline size_t parse_int( boost::string_view text, aligned_vector< Value_T >& out )
+{
+    return int_parser< Value_T, TAG_T >()( text, out );
+}
+
+}} // namespace simd_algorithms::string_algo
+
+#endif // SIMD_ALGORITHMS_PARSE_INT_H
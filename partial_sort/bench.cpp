@@ -0,0 +1,205 @@
+// MIT License
+//
+// Copyright (c) 2018 André Tupinambá
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "partial_sort.h"
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <numeric>
+#include <boost/timer/timer.hpp>
+
+bool g_verbose = true;
+namespace sa = simd_algorithms;
+
+void do_nothing( int32_t );
+
+constexpr size_t top_count = 100;
+
+template< class Cont_T, typename TAG_T >
+struct stl_top_k
+{
+	using container_type = Cont_T;
+
+    int32_t run( const container_type& cont )
+    {
+        container_type temp( cont );
+        std::partial_sort( temp.begin(), temp.begin() + top_count, temp.end(),
+                           std::greater< int32_t >() );
+        return temp[ top_count - 1 ];
+    }
+};
+
+template< class Cont_T, typename TAG_T >
+struct simd_top_k
+{
+	using container_type = Cont_T;
+
+    int32_t run( const container_type& cont )
+    {
+        return sa::sort::top_k< Cont_T, TAG_T >( top_count ).select( cont ).back();
+    }
+};
+
+template< class Cont_T, typename TAG_T >
+struct stl_partial_sort
+{
+	using container_type = Cont_T;
+
+    int32_t run( const container_type& cont )
+    {
+        container_type temp( cont );
+        std::partial_sort( temp.begin(), temp.begin() + top_count, temp.end() );
+        return temp[ top_count - 1 ];
+    }
+};
+
+template< class Cont_T, typename TAG_T >
+struct simd_partial_sort
+{
+	using container_type = Cont_T;
+
+    int32_t run( const container_type& cont )
+    {
+        container_type temp( cont );
+        sa::sort::partial_sort< Cont_T, TAG_T >( top_count ).sort( temp );
+        return temp[ top_count - 1 ];
+    }
+};
+
+template< class Cont_T, typename TAG_T >
+struct stl_median
+{
+	using container_type = Cont_T;
+
+    int32_t run( const container_type& cont )
+    {
+        container_type temp( cont );
+        auto nth = temp.begin() + temp.size() / 2;
+        std::nth_element( temp.begin(), nth, temp.end() );
+        return *nth;
+    }
+};
+
+template< class Cont_T, typename TAG_T >
+struct simd_median
+{
+	using container_type = Cont_T;
+
+    int32_t run( const container_type& cont )
+    {
+        return sa::sort::nth_element< Cont_T, TAG_T >().select( cont, cont.size() / 2 );
+    }
+};
+
+template< class Cont_T, template< typename...> class Select_T, typename TAG_T >
+uint64_t bench( const std::string& name, size_t size, size_t loop )
+{
+	using container_type = Cont_T;
+    using select_type = Select_T< container_type, TAG_T >;
+
+    boost::timer::cpu_timer timer;
+    container_type org;
+
+    srand(1);
+    std::generate_n( std::back_inserter(org), size, &rand );
+
+    select_type select;
+    do_nothing( select.run( org ) );
+
+    timer.start();
+    for( size_t j = 0; j < loop; ++j )
+    {
+        do_nothing( select.run( org ) );
+    }
+    timer.stop();
+    if( g_verbose )
+        std::cout << name << ": " << timer.format();
+
+    return timer.elapsed().wall;
+}
+
+int main(int argc, char* /*argv*/[])
+{
+    constexpr size_t runSize = 0x01000000;
+    constexpr size_t loop = 10;
+    if( argc > 1 )
+    {
+        g_verbose = false;
+        std::cout << "count,STL top k,SSE top k,AVX top k,STL median,SSE median,AVX median" << std::endl;
+    }
+    else
+    {
+        std::cout << "\nsize: 0x" << std::hex << std::setw(8) << std::setfill( '0') << runSize << std::endl << std::endl;
+    }
+    size_t cnt = 0;
+    while( 1 )
+    {
+        uint64_t stltop = bench< sa::aligned_vector< int32_t >, stl_top_k,
+                                 sa::sse_tag >( "STL top k ..........", runSize, loop );
+        uint64_t ssetop = bench< sa::aligned_vector< int32_t >, simd_top_k,
+                                 sa::sse_tag >( "SSE top k ..........", runSize, loop );
+        uint64_t avxtop = bench< sa::aligned_vector< int32_t >, simd_top_k,
+                                 sa::avx_tag >( "AVX top k ..........", runSize, loop );
+        uint64_t stlmed = bench< sa::aligned_vector< int32_t >, stl_median,
+                                 sa::sse_tag >( "STL median .........", runSize, loop );
+        uint64_t ssemed = bench< sa::aligned_vector< int32_t >, simd_median,
+                                 sa::sse_tag >( "SSE median .........", runSize, loop );
+        uint64_t avxmed = bench< sa::aligned_vector< int32_t >, simd_median,
+                                 sa::avx_tag >( "AVX median .........", runSize, loop );
+
+        if( g_verbose )
+        {
+            bench< sa::aligned_vector< int32_t >, stl_partial_sort,
+                   sa::sse_tag >( "STL partial sort ...", runSize, loop );
+            bench< sa::aligned_vector< int32_t >, simd_partial_sort,
+                   sa::sse_tag >( "SSE partial sort ...", runSize, loop );
+            bench< sa::aligned_vector< int32_t >, simd_partial_sort,
+                   sa::avx_tag >( "AVX partial sort ...", runSize, loop );
+
+            std::cout
+                << std::endl << "SSE top k Speed up ..: " << std::fixed << std::setprecision(2)
+                << static_cast<float>(stltop)/static_cast<float>(ssetop) << "x"
+                << std::endl << "AVX top k Speed up ..: " << std::fixed << std::setprecision(2)
+                << static_cast<float>(stltop)/static_cast<float>(avxtop) << "x"
+                << std::endl << "SSE median Speed up .: " << std::fixed << std::setprecision(2)
+                << static_cast<float>(stlmed)/static_cast<float>(ssemed) << "x"
+                << std::endl << "AVX median Speed up .: " << std::fixed << std::setprecision(2)
+                << static_cast<float>(stlmed)/static_cast<float>(avxmed) << "x"
+
+                << std::endl << std::endl;
+        }
+        else
+        {
+            std::cout
+                << ++cnt << ","
+                << stltop << ","
+                << ssetop << ","
+                << avxtop << ","
+                << stlmed << ","
+                << ssemed << ","
+                << avxmed
+                << std::endl;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,307 @@
+// MIT License
+//
+// Copyright (c) 2018 André Tupinambá
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef SIMD_ALGORITHMS_PARTIAL_SORT_H
+#define SIMD_ALGORITHMS_PARTIAL_SORT_H
+
+#include <immintrin.h>
+#include <x86intrin.h>
+#include <algorithm>
+#include <functional>
+#include "../simd_compare.h"
+
+namespace simd_algorithms{
+namespace sort{
+
+// Keeps the k best elements of a container. Whole registers are compared against the
+// current k-th best value (the threshold) and only the lanes that beat it are copied to
+// the candidate buffer, so for small k almost every register is discarded by one compare.
+template< class Cont_T, typename TAG_T, bool Largest_T >
+class kselect
+{
+public:
+	using container_type = Cont_T;
+    using value_type     = typename container_type::value_type;
+    using simd_type      = typename traits< value_type, TAG_T >::simd_type;
+
+    // Returns the k best elements, descending for largest and ascending for smallest
+    container_type select( const container_type& cont, size_t k ) const
+    {
+        container_type best;
+        size_t size = cont.size();
+        if( k == 0 )
+            return best;
+
+        if( k >= size )
+        {
+            best = cont;
+            std::sort( best.begin(), best.end(), compare() );
+            return best;
+        }
+
+        // Seed with the first k elements, rounded up to keep the registers aligned
+        size_t seed = std::min( size, (k + array_size - 1) & ~(array_size - 1) );
+        best.reserve( 2 * k + array_size );
+        best.assign( cont.begin(), std::next( cont.begin(), seed ) );
+        value_type threshold = shrink( best, k );
+
+        size_t end = seed + ((size - seed) & ~(array_size - 1));
+        const simd_type* data = reinterpret_cast< const simd_type* >( &cont[ seed ] );
+        for( size_t i = seed; i < end; i += array_size, ++data )
+        {
+            uint32_t mask = candidate_mask( threshold, *data );
+            while( mask != 0 )
+            {
+                uint32_t lane = _bit_scan_forward( mask ) / sizeof(value_type);
+                mask &= ~(lane_bits << (lane * sizeof(value_type)));
+                best.push_back( cont[ i + lane ] );
+            }
+
+            if( best.size() >= 2 * k )
+            {
+                threshold = shrink( best, k );
+            }
+        }
+
+        for( size_t i = end; i < size; ++i )
+        {
+            if( compare()( cont[i], threshold ) )
+                best.push_back( cont[i] );
+        }
+
+        shrink( best, k );
+        std::sort( best.begin(), best.end(), compare() );
+        return best;
+    }
+
+private:
+    constexpr static size_t array_size = traits< value_type, TAG_T >::simd_size;
+    constexpr static uint32_t lane_bits = (1u << sizeof(value_type)) - 1;
+
+    using compare = typename std::conditional< Largest_T,
+                                               std::greater< value_type >,
+                                               std::less< value_type > >::type;
+
+    static uint32_t candidate_mask( value_type threshold, simd_type cmp )
+    {
+        return Largest_T
+            ? less_than_mask< value_type, TAG_T >( threshold, cmp )
+            : greater_than_mask< value_type, TAG_T >( threshold, cmp );
+    }
+
+    // Drops everything but the k best candidates and returns the new threshold
+    static value_type shrink( container_type& best, size_t k )
+    {
+        auto kth = std::next( best.begin(), k - 1 );
+        std::nth_element( best.begin(), kth, best.end(), compare() );
+        best.resize( k );
+        return best.back();
+    }
+};
+
+template< class Cont_T, typename TAG_T >
+class top_k
+{
+public:
+	using container_type = Cont_T;
+    using value_type     = typename container_type::value_type;
+
+    top_k( size_t k )
+        : k_( k ){}
+
+    // Returns the k largest elements in descending order
+    container_type select( const container_type& cont ) const
+    {
+        return kselect< Cont_T, TAG_T, true >().select( cont, k_ );
+    }
+
+private:
+    size_t k_;
+};
+
+template< class Cont_T, typename TAG_T >
+class partial_sort
+{
+public:
+	using container_type = Cont_T;
+    using value_type     = typename container_type::value_type;
+    using simd_type      = typename traits< value_type, TAG_T >::simd_type;
+
+    partial_sort( size_t k )
+        : k_( k ){}
+
+    // Same result as std::partial_sort( begin, begin + k, end )
+    void sort( container_type& cont ) const
+    {
+        size_t k = std::min( k_, cont.size() );
+        if( k == 0 )
+            return;
+
+        container_type best = kselect< Cont_T, TAG_T, false >().select( cont, k );
+        value_type threshold = best.back();
+        size_t ties = std::count( best.begin(), best.end(), threshold );
+
+        // Compact the elements that were not selected to the back of the container.
+        // The write position never goes below the read position, so it is done in place.
+        size_t size = cont.size();
+        size_t out = size;
+        size_t end = size & ~(array_size - 1);
+        for( size_t i = size; i > end; --i )
+        {
+            keep( cont, cont[ i - 1 ], threshold, ties, out );
+        }
+
+        for( size_t i = end; i > 0; i -= array_size )
+        {
+            size_t beg = i - array_size;
+            auto cmp = reinterpret_cast< const simd_type* >( &cont[ beg ] );
+            if( less_than_mask< value_type, TAG_T >( threshold, *cmp ) == full_mask )
+            {
+                out -= array_size;
+                std::copy_backward( &cont[ beg ], &cont[ beg ] + array_size, &cont[ out ] + array_size );
+                continue;
+            }
+
+            for( size_t j = i; j > beg; --j )
+            {
+                keep( cont, cont[ j - 1 ], threshold, ties, out );
+            }
+        }
+
+        std::copy( best.begin(), best.end(), cont.begin() );
+    }
+
+private:
+    constexpr static size_t array_size = traits< value_type, TAG_T >::simd_size;
+    constexpr static uint32_t full_mask =
+        static_cast< uint32_t >( (1ull << sizeof(simd_type)) - 1 );
+
+    size_t k_;
+
+    static void keep( container_type& cont, value_type val, value_type threshold,
+                      size_t& ties, size_t& out )
+    {
+        if( val < threshold )
+            return;
+
+        if( val == threshold && ties > 0 )
+        {
+            --ties;
+            return;
+        }
+        cont[ --out ] = val;
+    }
+};
+
+template< class Cont_T, typename TAG_T >
+class nth_element
+{
+public:
+	using container_type = Cont_T;
+    using value_type     = typename container_type::value_type;
+    using simd_type      = typename traits< value_type, TAG_T >::simd_type;
+
+    // Returns the element that would be at position n if cont were sorted
+    value_type select( const container_type& cont, size_t n ) const
+    {
+        size_t size = cont.size();
+
+        // Close to either end it is a top-k problem
+        if( n < size / small_ratio )
+            return kselect< Cont_T, TAG_T, false >().select( cont, n + 1 ).back();
+
+        if( size - n <= size / small_ratio )
+            return kselect< Cont_T, TAG_T, true >().select( cont, size - n ).back();
+
+        // Bracket the n-th element with two values taken from a sorted sample, count what
+        // is below the bracket and keep only what is inside it
+        if( size >= 4 * sample_size )
+        {
+            container_type sample;
+            sample.reserve( sample_size );
+            size_t stride = size / sample_size;
+            for( size_t i = 0; i < sample_size; ++i )
+            {
+                sample.push_back( cont[ i * stride ] );
+            }
+            std::sort( sample.begin(), sample.end() );
+
+            size_t rank = std::min( n / stride, sample_size - 1 );
+            value_type lo = sample[ rank > margin ? rank - margin : 0 ];
+            value_type hi = sample[ std::min( rank + margin, sample_size - 1 ) ];
+
+            size_t below = 0;
+            container_type bucket;
+            bucket.reserve( 4 * margin * stride );
+
+            size_t end = size & ~(array_size - 1);
+            const simd_type* data = reinterpret_cast< const simd_type* >( &cont[ 0 ] );
+            for( size_t i = 0; i < end; i += array_size, ++data )
+            {
+                uint32_t lower = greater_than_mask< value_type, TAG_T >( lo, *data );
+                uint32_t inside = ~(lower | less_than_mask< value_type, TAG_T >( hi, *data ))
+                                & full_mask;
+                below += mask_to_count< value_type, TAG_T >( lower );
+                while( inside != 0 )
+                {
+                    uint32_t lane = _bit_scan_forward( inside ) / sizeof(value_type);
+                    inside &= ~(lane_bits << (lane * sizeof(value_type)));
+                    bucket.push_back( cont[ i + lane ] );
+                }
+            }
+
+            for( size_t i = end; i < size; ++i )
+            {
+                if( cont[i] < lo )
+                    ++below;
+                else if( !(hi < cont[i]) )
+                    bucket.push_back( cont[i] );
+            }
+
+            if( below <= n && n < below + bucket.size() )
+            {
+                auto nth = std::next( bucket.begin(), n - below );
+                std::nth_element( bucket.begin(), nth, bucket.end() );
+                return *nth;
+            }
+        }
+
+        // Small container or unlucky sample
+        container_type temp( cont );
+        auto nth = std::next( temp.begin(), n );
+        std::nth_element( temp.begin(), nth, temp.end() );
+        return *nth;
+    }
+
+private:
+    constexpr static size_t array_size = traits< value_type, TAG_T >::simd_size;
+    constexpr static uint32_t lane_bits = (1u << sizeof(value_type)) - 1;
+    constexpr static uint32_t full_mask =
+        static_cast< uint32_t >( (1ull << sizeof(simd_type)) - 1 );
+    constexpr static size_t small_ratio = 64;
+    constexpr static size_t sample_size = 4096;
+    constexpr static size_t margin = 64;
+};
+
+}} // namespace simd_algoriths::sort
+
+#endif // SIMD_ALGORITHMS_PARTIAL_SORT_H
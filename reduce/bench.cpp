@@ -0,0 +1,138 @@
+// MIT License
+//
+// Copyright (c) 2018 André Tupinambá
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "reduce.h"
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <numeric>
+#include <boost/timer/timer.hpp>
+
+bool g_verbose = true;
+namespace sa = simd_algorithms;
+
+void do_nothing( size_t );
+void do_nothing( int64_t );
+
+using container_type = sa::aligned_vector< int32_t >;
+
+template< typename TAG_T >
+struct std_reduce
+{
+    static void run( const container_type& in, container_type& out, size_t )
+    {
+        auto mm = std::minmax_element( in.begin(), in.end() );
+        do_nothing( static_cast< int64_t >( *mm.first ) + *mm.second );
+        do_nothing( static_cast< size_t >( std::min_element( in.begin(), in.end() ) - in.begin() ) );
+        do_nothing( std::accumulate( in.begin(), in.end(), int64_t( 0 ) ) );
+        std::partial_sum( in.begin(), in.end(), out.begin() );
+        do_nothing( static_cast< int64_t >( out.back() ) );
+    }
+};
+
+template< typename TAG_T >
+struct simd_reduce
+{
+    static void run( const container_type& in, container_type& out, size_t threads )
+    {
+        auto mm = sa::reduce::minmax< TAG_T >( in, threads );
+        do_nothing( static_cast< int64_t >( mm.first ) + mm.second );
+        do_nothing( sa::reduce::argmin< TAG_T >( in, threads ) );
+        do_nothing( sa::reduce::sum< TAG_T >( in, threads ) );
+        do_nothing( static_cast< int64_t >( sa::reduce::inclusive_scan< TAG_T >( in, out, threads ) ) );
+    }
+};
+
+template< template < typename > class REDUCE_T, typename TAG_T >
+uint64_t bench( const std::string& name, const container_type& in, size_t loop, size_t threads )
+{
+    boost::timer::cpu_timer timer;
+    container_type out( in.size() );
+
+    timer.start();
+    for( size_t j = 0; j < loop; ++j )
+    {
+        REDUCE_T< TAG_T >::run( in, out, threads );
+    }
+    timer.stop();
+    if( g_verbose )
+        std::cout << "Reduce " << name << ": " << timer.format();
+
+    return timer.elapsed().wall;
+}
+
+int main(int argc, char* /*argv*/[])
+{
+    constexpr size_t runSize = 0x00400000;
+    constexpr size_t loop = 20;
+    size_t threads = std::thread::hardware_concurrency();
+    if( argc > 1 )
+    {
+        g_verbose = false;
+        std::cout << "count,base,sse,avx,avx threads" << std::endl;
+    }
+    else
+    {
+        std::cout << "\nsize: 0x" << std::hex << std::setw(8) << std::setfill( '0') << runSize
+                  << std::dec << ", threads: " << threads << std::endl << std::endl;
+    }
+
+    container_type in;
+    srand( 1 );
+    std::generate_n( std::back_inserter( in ), runSize, [](){ return rand() % 2000 - 1000; } );
+
+    size_t cnt = 0;
+    while( 1 )
+    {
+        uint64_t base = bench< std_reduce, sa::sse_tag >( "std ........", in, loop, 1 );
+        uint64_t sse = bench< simd_reduce, sa::sse_tag >( "SSE ........", in, loop, 1 );
+        uint64_t avx = bench< simd_reduce, sa::avx_tag >( "AVX ........", in, loop, 1 );
+        uint64_t par = bench< simd_reduce, sa::avx_tag >( "AVX threads ", in, loop, threads );
+
+        if( g_verbose )
+        {
+            std::cout
+                      << std::endl << "Speed up SSE.......: " << std::fixed << std::setprecision(2)
+                      << static_cast<float>(base)/static_cast<float>(sse) << "x"
+
+                      << std::endl << "Speed up AVX.......: " << std::fixed << std::setprecision(2)
+                      << static_cast<float>(base)/static_cast<float>(avx) << "x"
+
+                      << std::endl << "Speed up threads...: " << std::fixed << std::setprecision(2)
+                      << static_cast<float>(base)/static_cast<float>(par) << "x"
+
+                      << std::endl << std::endl;
+        }
+        else
+        {
+            std::cout
+                << ++cnt << ","
+                << base << ","
+                << sse << ","
+                << avx << ","
+                << par
+                << std::endl;
+        }
+    }
+    return 0;
+}
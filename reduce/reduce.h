@@ -0,0 +1,359 @@
+// MIT License
+//
+// Copyright (c) 2018 André Tupinambá
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef SIMD_ALGORITHMS_REDUCE_H
+#define SIMD_ALGORITHMS_REDUCE_H
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "../simd_compare.h"
+
+namespace simd_algorithms{
+namespace reduce{
+
+// Register kernels over one part of an int32_t array. Lanes keep their own partial result and
+// are folded once at the end of the part. Indexes are tracked in 32 bit lanes, so parts are
+// never bigger than 2^30 values (run_parts).
+template< typename TAG_T >
+class reducer
+{
+public:
+    using simd_type = typename traits< int32_t, TAG_T >::simd_type;
+    using minmax_type = std::pair< int32_t, int32_t >;
+    using arg_type = std::pair< int32_t, size_t >;
+
+    constexpr static size_t array_size = traits< int32_t, TAG_T >::simd_size;
+    constexpr static size_t npos = static_cast< size_t >( -1 );
+
+    static minmax_type minmax( const int32_t* data, size_t size )
+    {
+        minmax_type ret( std::numeric_limits< int32_t >::max(), std::numeric_limits< int32_t >::min() );
+        size_t i = 0;
+        if( size >= array_size )
+        {
+            simd_type lo = loadu< int32_t, TAG_T >( data );
+            simd_type hi = lo;
+            for( i = array_size; i + array_size <= size; i += array_size )
+            {
+                simd_type val = loadu< int32_t, TAG_T >( data + i );
+                lo = minimum< int32_t, TAG_T >( lo, val );
+                hi = maximum< int32_t, TAG_T >( hi, val );
+            }
+            int32_t lanes_lo[ array_size ];
+            int32_t lanes_hi[ array_size ];
+            storeu< int32_t, TAG_T >( lanes_lo, lo );
+            storeu< int32_t, TAG_T >( lanes_hi, hi );
+            ret.first = *std::min_element( lanes_lo, lanes_lo + array_size );
+            ret.second = *std::max_element( lanes_hi, lanes_hi + array_size );
+        }
+        for( ; i < size; ++i )
+        {
+            ret.first = std::min( ret.first, data[i] );
+            ret.second = std::max( ret.second, data[i] );
+        }
+        return ret;
+    }
+
+    // First position of the smallest (Max_T false) or largest value, npos when empty
+    template< bool Max_T >
+    static arg_type arg( const int32_t* data, size_t size )
+    {
+        arg_type ret( 0, npos );
+        size_t i = 0;
+        if( size >= array_size )
+        {
+            simd_type best = loadu< int32_t, TAG_T >( data );
+            simd_type index = first_indices();
+            simd_type best_index = index;
+            for( i = array_size; i + array_size <= size; i += array_size )
+            {
+                simd_type val = loadu< int32_t, TAG_T >( data + i );
+                index = add< int32_t, TAG_T >( index, array_size );
+
+                // Strictly better, so every lane keeps its first best
+                simd_type better = Max_T ? greater_than< int32_t, TAG_T >( val, best )
+                                         : greater_than< int32_t, TAG_T >( best, val );
+                best = iif< TAG_T >( better, val, best );
+                best_index = iif< TAG_T >( better, index, best_index );
+            }
+            int32_t lanes[ array_size ];
+            int32_t lanes_index[ array_size ];
+            storeu< int32_t, TAG_T >( lanes, best );
+            storeu< int32_t, TAG_T >( lanes_index, best_index );
+            ret = arg_type( lanes[0], static_cast< uint32_t >( lanes_index[0] ) );
+            for( size_t lane = 1; lane < array_size; ++lane )
+            {
+                arg_type cur( lanes[ lane ], static_cast< uint32_t >( lanes_index[ lane ] ) );
+                ret = better_arg< Max_T >( ret, cur ) ? ret : cur;
+            }
+        }
+        for( ; i < size; ++i )
+        {
+            bool better = (ret.second == npos) || (Max_T ? data[i] > ret.first : data[i] < ret.first);
+            ret = better ? arg_type( data[i], i ) : ret;
+        }
+        return ret;
+    }
+
+    // lhs comes first on ties, npos loses
+    template< bool Max_T >
+    static bool better_arg( const arg_type& lhs, const arg_type& rhs )
+    {
+        if( lhs.second == npos || rhs.second == npos )
+            return rhs.second == npos;
+        if( lhs.first != rhs.first )
+            return Max_T ? lhs.first > rhs.first : lhs.first < rhs.first;
+        return lhs.second < rhs.second;
+    }
+
+    static int64_t sum( const int32_t* data, size_t size )
+    {
+        simd_type acc0 = traits< int32_t, TAG_T >::zero();
+        simd_type acc1 = acc0;
+        size_t i = 0;
+        for( ; i + 2 * array_size <= size; i += 2 * array_size )
+        {
+            acc0 = widen_add< int32_t, TAG_T >( acc0, loadu< int32_t, TAG_T >( data + i ) );
+            acc1 = widen_add< int32_t, TAG_T >( acc1, loadu< int32_t, TAG_T >( data + i + array_size ) );
+        }
+        int64_t lanes0[ array_size / 2 ];
+        int64_t lanes1[ array_size / 2 ];
+        storeu< int32_t, TAG_T >( reinterpret_cast< int32_t* >( lanes0 ), acc0 );
+        storeu< int32_t, TAG_T >( reinterpret_cast< int32_t* >( lanes1 ), acc1 );
+        int64_t ret = 0;
+        for( size_t lane = 0; lane < array_size / 2; ++lane )
+        {
+            ret += lanes0[ lane ] + lanes1[ lane ];
+        }
+        for( ; i < size; ++i )
+        {
+            ret += data[i];
+        }
+        return ret;
+    }
+
+    // Running sum of data plus carry to out (which may be data), returns carry plus the sum.
+    // The exclusive version leaves each value out of its own position. Sums wrap around
+    template< bool Exclusive_T >
+    static int32_t scan( const int32_t* data, size_t size, int32_t* out, int32_t carry )
+    {
+        // Every lane holds the sum so far
+        simd_type total = broadcast< int32_t, TAG_T >( carry );
+        size_t i = 0;
+        for( ; i + array_size <= size; i += array_size )
+        {
+            simd_type incl = add< int32_t, TAG_T >( prefix_sum< int32_t, TAG_T >( loadu< int32_t, TAG_T >( data + i ) ),
+                                                    total );
+            storeu< int32_t, TAG_T >( out + i, Exclusive_T ? prev_bytes< 4, TAG_T >( incl, total ) : incl );
+            total = select< int32_t, TAG_T >( incl, array_size - 1 );
+        }
+
+        int32_t lanes[ array_size ];
+        storeu< int32_t, TAG_T >( lanes, total );
+        uint32_t acc = static_cast< uint32_t >( lanes[0] );
+        for( ; i < size; ++i )
+        {
+            uint32_t val = static_cast< uint32_t >( data[i] );
+            acc += val;
+            out[i] = static_cast< int32_t >( Exclusive_T ? acc - val : acc );
+        }
+        return static_cast< int32_t >( acc );
+    }
+
+private:
+    static simd_type first_indices()
+    {
+        int32_t index[ array_size ];
+        for( size_t i = 0; i < array_size; ++i )
+        {
+            index[ i ] = static_cast< int32_t >( i );
+        }
+        return loadu< int32_t, TAG_T >( index );
+    }
+
+};
+
+// Splits [0, size) in parts of whole cache lines, at least min_part values each unless there is
+// only one, and runs task( part, first, count ) for all of them on up to threads threads.
+// Part 0 runs on the calling thread
+template< typename Task_T >
+size_t run_parts( size_t size, size_t threads, Task_T task )
+{
+    enum : size_t { min_part = 1 << 16, max_part = 1 << 30, line = 16 };
+
+    size_t parts = std::min( std::max< size_t >( threads, 1 ), std::max< size_t >( size / min_part, 1 ) );
+    parts = std::max( parts, (size + max_part - 1) / max_part );
+    size_t step = std::max< size_t >( ((size + parts - 1) / parts + line - 1) / line * line, line );
+    parts = std::max< size_t >( (size + step - 1) / step, 1 );
+    threads = std::min( std::max< size_t >( threads, 1 ), parts );
+
+    auto worker = [&]( size_t first_part )
+    {
+        for( size_t part = first_part; part < parts; part += threads )
+        {
+            size_t first = std::min( part * step, size );
+            task( part, first, std::min( step, size - first ) );
+        }
+    };
+
+    std::vector< std::thread > workers;
+    for( size_t t = 1; t < threads; ++t )
+    {
+        workers.emplace_back( worker, t );
+    }
+    worker( 0 );
+    for( auto&& w : workers )
+    {
+        w.join();
+    }
+    return parts;
+}
+
+// The reductions take the number of threads, the default runs on the calling thread only.
+// Arrays smaller than two parts are not split.
+
+// Smallest and largest value
+template< typename TAG_T >
+std::pair< int32_t, int32_t > minmax( const aligned_vector< int32_t >& in, size_t threads = 1 )
+{
+    using minmax_type = typename reducer< TAG_T >::minmax_type;
+    std::vector< minmax_type > results( threads + (in.size() >> 30) + 1 );
+    size_t parts = run_parts( in.size(), threads, [&]( size_t part, size_t first, size_t count )
+    {
+        results[ part ] = reducer< TAG_T >::minmax( in.data() + first, count );
+    } );
+
+    minmax_type ret = results[0];
+    for( size_t part = 1; part < parts; ++part )
+    {
+        ret.first = std::min( ret.first, results[ part ].first );
+        ret.second = std::max( ret.second, results[ part ].second );
+    }
+    return ret;
+}
+
+// Smallest value, std::numeric_limits< int32_t >::max() when in is empty
+template< typename TAG_T >
+int32_t min( const aligned_vector< int32_t >& in, size_t threads = 1 )
+{
+    return minmax< TAG_T >( in, threads ).first;
+}
+
+// Largest value, std::numeric_limits< int32_t >::min() when in is empty
+template< typename TAG_T >
+int32_t max( const aligned_vector< int32_t >& in, size_t threads = 1 )
+{
+    return minmax< TAG_T >( in, threads ).second;
+}
+
+template< typename TAG_T, bool Max_T >
+size_t arg( const aligned_vector< int32_t >& in, size_t threads )
+{
+    using arg_type = typename reducer< TAG_T >::arg_type;
+    std::vector< arg_type > results( threads + (in.size() >> 30) + 1 );
+    size_t parts = run_parts( in.size(), threads, [&]( size_t part, size_t first, size_t count )
+    {
+        results[ part ] = reducer< TAG_T >::template arg< Max_T >( in.data() + first, count );
+        results[ part ].second += (results[ part ].second == reducer< TAG_T >::npos) ? 0 : first;
+    } );
+
+    arg_type ret = results[0];
+    for( size_t part = 1; part < parts; ++part )
+    {
+        ret = reducer< TAG_T >::template better_arg< Max_T >( ret, results[ part ] ) ? ret : results[ part ];
+    }
+    return (ret.second == reducer< TAG_T >::npos) ? in.size() : ret.second;
+}
+
+// Position of the first smallest value, in.size() when in is empty
+template< typename TAG_T >
+size_t argmin( const aligned_vector< int32_t >& in, size_t threads = 1 )
+{
+    return arg< TAG_T, false >( in, threads );
+}
+
+// Position of the first largest value, in.size() when in is empty
+template< typename TAG_T >
+size_t argmax( const aligned_vector< int32_t >& in, size_t threads = 1 )
+{
+    return arg< TAG_T, true >( in, threads );
+}
+
+// Sum in 64 bit accumulators, it does not overflow
+template< typename TAG_T >
+int64_t sum( const aligned_vector< int32_t >& in, size_t threads = 1 )
+{
+    std::vector< int64_t > results( threads + (in.size() >> 30) + 1 );
+    size_t parts = run_parts( in.size(), threads, [&]( size_t part, size_t first, size_t count )
+    {
+        results[ part ] = reducer< TAG_T >::sum( in.data() + first, count );
+    } );
+    return std::accumulate( results.begin(), results.begin() + parts, int64_t( 0 ) );
+}
+
+// Running sums, 32 bits wrapping around. In parallel each part is summed first, then
+// scanned from the sum of the parts before it
+template< typename TAG_T, bool Exclusive_T >
+int32_t scan( const aligned_vector< int32_t >& in, aligned_vector< int32_t >& out, size_t threads )
+{
+    out.resize( in.size() );
+    if( threads <= 1 || in.size() < 2 * (1 << 16) )
+        return reducer< TAG_T >::template scan< Exclusive_T >( in.data(), in.size(), out.data(), 0 );
+
+    std::vector< int32_t > carry( threads + (in.size() >> 30) + 2, 0 );
+    size_t parts = run_parts( in.size(), threads, [&]( size_t part, size_t first, size_t count )
+    {
+        carry[ part + 1 ] = static_cast< int32_t >( reducer< TAG_T >::sum( in.data() + first, count ) );
+    } );
+    for( size_t part = 1; part <= parts; ++part )
+    {
+        carry[ part ] = static_cast< int32_t >( static_cast< uint32_t >( carry[ part ] ) +
+                                                static_cast< uint32_t >( carry[ part - 1 ] ) );
+    }
+    run_parts( in.size(), threads, [&]( size_t part, size_t first, size_t count )
+    {
+        reducer< TAG_T >::template scan< Exclusive_T >( in.data() + first, count, out.data() + first, carry[ part ] );
+    } );
+    return carry[ parts ];
+}
+
+// out[i] = in[0] + ... + in[i], out may be in. Returns the total
+template< typename TAG_T >
+int32_t inclusive_scan( const aligned_vector< int32_t >& in, aligned_vector< int32_t >& out, size_t threads = 1 )
+{
+    return scan< TAG_T, false >( in, out, threads );
+}
+
+// out[i] = in[0] + ... + in[i-1], out[0] = 0, out may be in. Returns the total
+template< typename TAG_T >
+int32_t exclusive_scan( const aligned_vector< int32_t >& in, aligned_vector< int32_t >& out, size_t threads = 1 )
+{
+    return scan< TAG_T, true >( in, out, threads );
+}
+
+}} // namespace simd_algorithms::reduce
+
+#endif // SIMD_ALGORITHMS_REDUCE_H
@@ -0,0 +1,156 @@
+// MIT License
+//
+// Copyright (c) 2018 André Tupinambá
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "replicated_index.h"
+#include "../nway_tree/nway_tree.h"
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <numeric>
+#include <boost/timer/timer.hpp>
+
+bool g_verbose = true;
+namespace sa = simd_algorithms;
+
+void do_nothing( int32_t );
+
+using container_type = sa::aligned_vector< int32_t >;
+using index_type = sa::nway_tree::index< container_type, sa::avx_tag >;
+
+// One thread per CPU of every node, all running at once. Returns the lookups per second of each
+// node, the sum of its threads. Each worker copies the keys after it is pinned, so the probe
+// stream is local too, and asks make_find for its lookup once, pinned callers route only once.
+template< class Make_Find_T >
+std::vector< double > run_nodes( const sa::numa_topology& topology, const container_type& keys, size_t loop,
+                                 Make_Find_T make_find )
+{
+    std::vector< std::vector< double > > rates( topology.node_count() );
+    std::vector< std::thread > workers;
+    for( size_t node = 0; node < topology.node_count(); ++node )
+    {
+        rates[ node ].resize( topology.cpus( node ).size() );
+        for( size_t i = 0; i < topology.cpus( node ).size(); ++i )
+        {
+            workers.emplace_back( [&, node, i]()
+            {
+                sa::numa_topology::bind_thread( { topology.cpus( node )[ i ] } );
+                container_type local_keys( keys );
+                auto find = make_find();
+
+                boost::timer::cpu_timer timer;
+                for( size_t j = 0; j < loop; ++j )
+                {
+                    for( auto key : local_keys )
+                    {
+                        do_nothing( static_cast< int32_t >( find( key ) ) );
+                    }
+                }
+                timer.stop();
+                rates[ node ][ i ] = keys.size() * loop * 1e9 / timer.elapsed().wall;
+            } );
+        }
+    }
+    for( auto& worker : workers )
+    {
+        worker.join();
+    }
+
+    std::vector< double > total;
+    for( auto& node : rates )
+    {
+        total.push_back( std::accumulate( node.begin(), node.end(), 0.0 ) );
+    }
+    return total;
+}
+
+int main(int argc, char* /*argv*/[])
+{
+    constexpr size_t runSize = 0x00400000;
+    constexpr size_t loop = 4;
+
+    sa::numa_topology topology;
+    if( argc > 1 )
+    {
+        g_verbose = false;
+        std::cout << "count";
+        for( size_t node = 0; node < topology.node_count(); ++node )
+        {
+            std::cout << ",shared node " << node << ",replicated node " << node;
+        }
+        std::cout << std::endl;
+    }
+    else
+    {
+        std::cout << "\nsize: 0x" << std::hex << std::setw(8) << std::setfill( '0') << runSize << std::dec
+                  << ", nodes: " << topology.node_count() << std::endl << std::endl;
+    }
+
+    srand( 1 );
+    container_type sorted;
+    std::generate_n( std::back_inserter( sorted ), runSize, rand );
+    std::sort( sorted.begin(), sorted.end() );
+    container_type keys;
+    std::generate_n( std::back_inserter( keys ), runSize, [&](){ return sorted[ rand() % runSize ]; } );
+
+    // The shared index lives where the main thread first touched it
+    index_type shared( sorted );
+    shared.build_index();
+    sa::replicated_index< index_type > replicated( sorted, topology );
+    replicated.build_index();
+
+    size_t cnt = 0;
+    while( 1 )
+    {
+        std::vector< double > sharedRate = run_nodes( topology, keys, loop, [&](){
+            return [&]( int32_t key ){ return std::distance( sorted.cbegin(), shared.find( key ) ); };
+        } );
+        std::vector< double > replicatedRate = run_nodes( topology, keys, loop, [&](){
+            const auto& copy = replicated.local();
+            return [&copy]( int32_t key ){ return std::distance( copy.data.cbegin(), copy.index.find( key ) ); };
+        } );
+
+        if( g_verbose )
+        {
+            for( size_t node = 0; node < topology.node_count(); ++node )
+            {
+                std::cout << "Node " << node << " (" << topology.cpus( node ).size() << " cpus) "
+                          << std::fixed << std::setprecision(2)
+                          << "shared: " << sharedRate[ node ] / 1e6 << " M/s, "
+                          << "replicated: " << replicatedRate[ node ] / 1e6 << " M/s, "
+                          << "speed up: " << replicatedRate[ node ] / sharedRate[ node ] << "x" << std::endl;
+            }
+            std::cout << std::endl;
+        }
+        else
+        {
+            std::cout << ++cnt;
+            for( size_t node = 0; node < topology.node_count(); ++node )
+            {
+                std::cout << "," << static_cast< uint64_t >( sharedRate[ node ] )
+                          << "," << static_cast< uint64_t >( replicatedRate[ node ] );
+            }
+            std::cout << std::endl;
+        }
+    }
+    return 0;
+}
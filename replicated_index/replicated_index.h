@@ -0,0 +1,244 @@
+// MIT License
+//
+// Copyright (c) 2018 André Tupinambá
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef SIMD_ALGORITHMS_REPLICATED_INDEX_H
+#define SIMD_ALGORITHMS_REPLICATED_INDEX_H
+
+#include <sched.h>
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../simd_compare.h"
+
+namespace simd_algorithms{
+
+// NUMA nodes and their CPUs as listed in sysfs. Nodes are numbered from 0 in the order the kernel
+// lists them. Without sysfs the host is taken as a single node with every CPU.
+class numa_topology
+{
+public:
+    numa_topology()
+    {
+        const std::string root = "/sys/devices/system/node/";
+        for( int id : parse_cpu_list( read_line( root + "online" ) ) )
+        {
+            std::vector< int > cpus = parse_cpu_list( read_line( root + "node" + std::to_string( id ) + "/cpulist" ) );
+            if( !cpus.empty() )
+            {
+                add_node( cpus );
+            }
+        }
+        if( nodes_.empty() )
+        {
+            std::vector< int > cpus( std::max( std::thread::hardware_concurrency(), 1u ) );
+            for( size_t i = 0; i < cpus.size(); ++i )
+            {
+                cpus[ i ] = static_cast< int >( i );
+            }
+            add_node( cpus );
+        }
+    }
+
+    // Explicit layout, one CPU list per node
+    explicit numa_topology( const std::vector< std::vector< int > >& nodes )
+    {
+        for( auto& cpus : nodes )
+        {
+            add_node( cpus );
+        }
+    }
+
+    size_t node_count() const
+    {
+        return nodes_.size();
+    }
+
+    const std::vector< int >& cpus( size_t node ) const
+    {
+        return nodes_[ node ];
+    }
+
+    size_t node_of_cpu( int cpu ) const
+    {
+        return (cpu >= 0 && static_cast< size_t >( cpu ) < cpu_node_.size()) ? cpu_node_[ cpu ] : 0;
+    }
+
+    // Node of the CPU the calling thread runs on now
+    size_t current_node() const
+    {
+        return node_of_cpu( sched_getcpu() );
+    }
+
+    // Restricts the calling thread to cpus
+    static bool bind_thread( const std::vector< int >& cpus )
+    {
+        cpu_set_t set;
+        CPU_ZERO( &set );
+        for( int cpu : cpus )
+        {
+            CPU_SET( cpu, &set );
+        }
+        return sched_setaffinity( 0, sizeof( set ), &set ) == 0;
+    }
+
+    // "0-3,8,10-11" style lists
+    static std::vector< int > parse_cpu_list( const std::string& list )
+    {
+        std::vector< int > cpus;
+        std::stringstream in( list );
+        std::string range;
+        while( std::getline( in, range, ',' ) )
+        {
+            if( range.empty() || !isdigit( range[ 0 ] ) )
+                continue;
+            size_t dash = range.find( '-' );
+            int first = std::stoi( range );
+            int last = (dash == std::string::npos) ? first : std::stoi( range.substr( dash + 1 ) );
+            for( int cpu = first; cpu <= last; ++cpu )
+            {
+                cpus.push_back( cpu );
+            }
+        }
+        return cpus;
+    }
+
+private:
+    std::vector< std::vector< int > > nodes_;
+    std::vector< size_t > cpu_node_;
+
+    void add_node( const std::vector< int >& cpus )
+    {
+        for( int cpu : cpus )
+        {
+            if( static_cast< size_t >( cpu ) >= cpu_node_.size() )
+            {
+                cpu_node_.resize( cpu + 1, 0 );
+            }
+            cpu_node_[ cpu ] = nodes_.size();
+        }
+        nodes_.push_back( cpus );
+    }
+
+    static std::string read_line( const std::string& path )
+    {
+        std::ifstream file( path );
+        std::string line;
+        std::getline( file, line );
+        return line;
+    }
+};
+
+// Read only index copied to every NUMA node. build_index builds each copy, data and tree, on a
+// thread bound to the node, so first touch places its pages in the node memory. Lookups go to the
+// copy of the node the calling thread runs on. Index_T is any index with the nway_tree interface.
+template< class Index_T >
+class replicated_index
+{
+public:
+    using container_type = typename Index_T::container_type;
+    using value_type     = typename Index_T::value_type;
+    using const_iterator = typename Index_T::const_iterator;
+
+    struct replica
+    {
+        replica( const container_type& ref )
+            : data( ref ), index( data )
+        {
+            index.build_index();
+        }
+
+        container_type data;
+        Index_T index;
+    };
+
+    replicated_index( const container_type& ref, const numa_topology& topology = numa_topology() )
+        : ref_( ref ), topology_( topology ){}
+
+    void build_index()
+    {
+        replicas_.clear();
+        replicas_.resize( topology_.node_count() );
+
+        std::vector< std::thread > builders;
+        for( size_t node = 0; node < replicas_.size(); ++node )
+        {
+            builders.emplace_back( [this, node]()
+            {
+                numa_topology::bind_thread( topology_.cpus( node ) );
+                replicas_[ node ].reset( new replica( ref_ ) );
+            } );
+        }
+        for( auto& builder : builders )
+        {
+            builder.join();
+        }
+    }
+
+    size_t size() const
+    {
+        return ref_.size();
+    }
+
+    size_t replica_count() const
+    {
+        return replicas_.size();
+    }
+
+    const numa_topology& topology() const
+    {
+        return topology_;
+    }
+
+    const replica& on_node( size_t node ) const
+    {
+        return *replicas_[ node ];
+    }
+
+    // Copy of the node the calling thread runs on. Threads pinned to a node should take it once
+    // and search it directly, find pays sched_getcpu on every call.
+    const replica& local() const
+    {
+        return *replicas_[ topology_.current_node() ];
+    }
+
+    // Position of key, size() when it is not found, for threads that may move between nodes.
+    // Positions are the same in every copy.
+    size_t find( const value_type& key ) const
+    {
+        const replica& copy = local();
+        return std::distance( copy.data.cbegin(), copy.index.find( key ) );
+    }
+
+private:
+    const container_type& ref_;
+    numa_topology topology_;
+    std::vector< std::unique_ptr< replica > > replicas_;
+};
+
+} // namespace simd_algorithms
+
+#endif // SIMD_ALGORITHMS_REPLICATED_INDEX_H
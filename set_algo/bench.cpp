@@ -0,0 +1,171 @@
+// MIT License
+//
+// Copyright (c) 2018 André Tupinambá
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "set_algo.h"
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <iterator>
+#include <boost/timer/timer.hpp>
+
+bool g_verbose = true;
+namespace sa = simd_algorithms;
+
+void do_nothing( size_t );
+
+using container_type = sa::aligned_vector< int32_t >;
+
+template< typename TAG_T >
+struct std_set
+{
+    static size_t intersection( const container_type& a, const container_type& b, container_type& out )
+    {
+        out.clear();
+        std::set_intersection( a.begin(), a.end(), b.begin(), b.end(), std::back_inserter( out ) );
+        return out.size();
+    }
+
+    static size_t join( const container_type& a, const container_type& b, container_type& out )
+    {
+        out.clear();
+        std::set_union( a.begin(), a.end(), b.begin(), b.end(), std::back_inserter( out ) );
+        return out.size();
+    }
+
+    static size_t difference( const container_type& a, const container_type& b, container_type& out )
+    {
+        out.clear();
+        std::set_difference( a.begin(), a.end(), b.begin(), b.end(), std::back_inserter( out ) );
+        return out.size();
+    }
+};
+
+template< typename TAG_T >
+struct simd_set
+{
+    static size_t intersection( const container_type& a, const container_type& b, container_type& out )
+    {
+        return sa::set_algo::set_intersection< TAG_T >( a, b, out );
+    }
+
+    static size_t join( const container_type& a, const container_type& b, container_type& out )
+    {
+        return sa::set_algo::set_union< TAG_T >( a, b, out );
+    }
+
+    static size_t difference( const container_type& a, const container_type& b, container_type& out )
+    {
+        return sa::set_algo::set_difference< TAG_T >( a, b, out );
+    }
+};
+
+container_type make_set( size_t size, int32_t spread )
+{
+    container_type ret;
+    int32_t val = 0;
+    for( size_t i = 0; i < size; ++i )
+    {
+        val += 1 + rand() % spread;
+        ret.push_back( val );
+    }
+    return ret;
+}
+
+template< template < typename > class SET_T, typename TAG_T >
+uint64_t bench( const std::string& name, const container_type& a, const container_type& b, size_t loop )
+{
+    using set_type = SET_T< TAG_T >;
+    boost::timer::cpu_timer timer;
+    container_type out;
+
+    timer.start();
+    for( size_t j = 0; j < loop; ++j )
+    {
+        do_nothing( set_type::intersection( a, b, out ) );
+        do_nothing( set_type::join( a, b, out ) );
+        do_nothing( set_type::difference( a, b, out ) );
+    }
+    timer.stop();
+    if( g_verbose )
+        std::cout << "Set operations " << name << ": " << timer.format();
+
+    return timer.elapsed().wall;
+}
+
+int main(int argc, char* /*argv*/[])
+{
+    constexpr size_t runSize = 0x00100000;
+    constexpr size_t loop = 20;
+    if( argc > 1 )
+    {
+        g_verbose = false;
+        std::cout << "count,base,sse,avx,skewed base,skewed avx" << std::endl;
+    }
+    else
+    {
+        std::cout << "\nsize: 0x" << std::hex << std::setw(8) << std::setfill( '0') << runSize << std::endl << std::endl;
+    }
+
+    // About half of the values are in both lists
+    srand( 1 );
+    container_type a = make_set( runSize, 3 );
+    container_type b = make_set( runSize, 3 );
+    container_type small = make_set( runSize / 1000, 3000 );
+
+    size_t cnt = 0;
+    while( 1 )
+    {
+        uint64_t base = bench< std_set, sa::sse_tag >( "std ..........", a, b, loop );
+        uint64_t sse = bench< simd_set, sa::sse_tag >( "SSE ..........", a, b, loop );
+        uint64_t avx = bench< simd_set, sa::avx_tag >( "AVX ..........", a, b, loop );
+        uint64_t skew_base = bench< std_set, sa::sse_tag >( "skewed std ...", small, a, loop );
+        uint64_t skew_avx = bench< simd_set, sa::avx_tag >( "skewed AVX ...", small, a, loop );
+
+        if( g_verbose )
+        {
+            std::cout
+                      << std::endl << "Speed up SSE.......: " << std::fixed << std::setprecision(2)
+                      << static_cast<float>(base)/static_cast<float>(sse) << "x"
+
+                      << std::endl << "Speed up AVX.......: " << std::fixed << std::setprecision(2)
+                      << static_cast<float>(base)/static_cast<float>(avx) << "x"
+
+                      << std::endl << "Speed up skewed AVX: " << std::fixed << std::setprecision(2)
+                      << static_cast<float>(skew_base)/static_cast<float>(skew_avx) << "x"
+
+                      << std::endl << std::endl;
+        }
+        else
+        {
+            std::cout
+                << ++cnt << ","
+                << base << ","
+                << sse << ","
+                << avx << ","
+                << skew_base << ","
+                << skew_avx
+                << std::endl;
+        }
+    }
+    return 0;
+}
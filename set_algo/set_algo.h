@@ -0,0 +1,333 @@
+// MIT License
+//
+// Copyright (c) 2018 André Tupinambá
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef SIMD_ALGORITHMS_SET_ALGO_H
+#define SIMD_ALGORITHMS_SET_ALGO_H
+
+#include <algorithm>
+#include "../simd_compare.h"
+#include "../binary_search/binary_search.h"
+
+namespace simd_algorithms{
+namespace set_algo{
+
+// Set operations on sorted int32_t lists with strictly increasing values (posting lists).
+//
+// Intersection and difference compare a register of each list all against all, the second
+// register is rotated array_size - 1 times and every rotation is matched with equal. The
+// register whose last value is smaller (or both) is then replaced by the next one of its list.
+// Union merges the next register of the list with the smallest head into the pending one with
+// a bitonic network and drops repeats by comparing each lane with the one before it.
+//
+// Selected lanes are packed with compress and always stored, the output pointer moves by the
+// selected count, so there is no branch per value. Writes can go array_size - 1 values past
+// the result, the container versions size the output for that.
+//
+// When one list is more than gallop_ratio times smaller, each of its values skips ahead in the
+// larger list with doubling steps and a SIMD lower_bound on the last step.
+template< typename TAG_T >
+class set_ops
+{
+public:
+    using container_type = aligned_vector< int32_t >;
+    using simd_type      = typename traits< int32_t, TAG_T >::simd_type;
+
+    constexpr static size_t array_size = traits< int32_t, TAG_T >::simd_size;
+    constexpr static size_t gallop_ratio = 32;
+
+    static size_t intersect( const int32_t* a, size_t na, const int32_t* b, size_t nb, int32_t* out )
+    {
+        if( skewed( na, nb ) ) return gallop_intersect( a, na, b, nb, out );
+        if( skewed( nb, na ) ) return gallop_intersect( b, nb, a, na, out );
+
+        int32_t* dst = out;
+        size_t i = 0;
+        size_t j = 0;
+        while( i + array_size <= na && j + array_size <= nb )
+        {
+            simd_type va = loadu< int32_t, TAG_T >( a + i );
+            uint32_t mask = match( va, loadu< int32_t, TAG_T >( b + j ) );
+            storeu< int32_t, TAG_T >( dst, compress< int32_t, TAG_T >( va, mask ) );
+            dst += _mm_popcnt_u32( mask );
+
+            int32_t amax = a[ i + array_size - 1 ];
+            int32_t bmax = b[ j + array_size - 1 ];
+            i += (amax <= bmax) ? array_size : 0;
+            j += (bmax <= amax) ? array_size : 0;
+        }
+
+        // Values of a already matched are smaller than b[j], the scalar tail can not repeat them
+        while( i < na && j < nb )
+        {
+            int32_t av = a[ i ];
+            int32_t bv = b[ j ];
+            *dst = av;
+            dst += (av == bv);
+            i += (av <= bv);
+            j += (bv <= av);
+        }
+        return dst - out;
+    }
+
+    static size_t unite( const int32_t* a, size_t na, const int32_t* b, size_t nb, int32_t* out )
+    {
+        if( skewed( na, nb ) ) return gallop_unite( a, na, b, nb, out );
+        if( skewed( nb, na ) ) return gallop_unite( b, nb, a, na, out );
+
+        int32_t* dst = out;
+        size_t i = 0;
+        size_t j = 0;
+        int32_t pending[ array_size ];
+        size_t npending = 0;
+        if( na >= array_size && nb >= array_size )
+        {
+            simd_type lo = loadu< int32_t, TAG_T >( a );
+            simd_type hi = loadu< int32_t, TAG_T >( b );
+            i = j = array_size;
+
+            // Lane 0 of the first register is never a repeat
+            simd_type prev = broadcast< int32_t, TAG_T >( ~std::min( a[0], b[0] ) );
+            while( true )
+            {
+                bitonic_merge< int32_t, TAG_T >( lo, hi );
+                uint32_t mask = lane_mask< int32_t, TAG_T >(
+                    equal< int32_t, TAG_T >( lo, prev_bytes< 4, TAG_T >( lo, prev ) ) ) ^ all_lanes;
+                storeu< int32_t, TAG_T >( dst, compress< int32_t, TAG_T >( lo, mask ) );
+                dst += _mm_popcnt_u32( mask );
+                prev = lo;
+
+                if( i + array_size > na || j + array_size > nb )
+                    break;
+
+                // Every value not loaded yet is at least the smallest head
+                bool take_a = a[ i ] <= b[ j ];
+                lo = loadu< int32_t, TAG_T >( take_a ? a + i : b + j );
+                i += take_a ? array_size : 0;
+                j += take_a ? 0 : array_size;
+            }
+            storeu< int32_t, TAG_T >( pending, hi );
+            npending = array_size;
+            dst = unite_tail( pending, npending, a + i, na - i, b + j, nb - j,
+                              dst, true, dst[ -1 ] );
+            return dst - out;
+        }
+        dst = unite_tail( pending, npending, a + i, na - i, b + j, nb - j, dst, false, 0 );
+        return dst - out;
+    }
+
+    static size_t subtract( const int32_t* a, size_t na, const int32_t* b, size_t nb, int32_t* out )
+    {
+        if( skewed( na, nb ) ) return gallop_subtract_small( a, na, b, nb, out );
+        if( skewed( nb, na ) ) return gallop_subtract_large( a, na, b, nb, out );
+
+        int32_t* dst = out;
+        size_t i = 0;
+        size_t j = 0;
+        uint32_t found = 0;
+        while( i + array_size <= na && j + array_size <= nb )
+        {
+            simd_type va = loadu< int32_t, TAG_T >( a + i );
+            found |= match( va, loadu< int32_t, TAG_T >( b + j ) );
+
+            // A register of a is done only when it moves on
+            int32_t amax = a[ i + array_size - 1 ];
+            int32_t bmax = b[ j + array_size - 1 ];
+            uint32_t keep = (amax <= bmax) ? (found ^ all_lanes) : 0;
+            storeu< int32_t, TAG_T >( dst, compress< int32_t, TAG_T >( va, keep ) );
+            dst += _mm_popcnt_u32( keep );
+            found = (amax <= bmax) ? 0 : found;
+            i += (amax <= bmax) ? array_size : 0;
+            j += (bmax <= amax) ? array_size : 0;
+        }
+
+        for( size_t k = 0; i < na; ++i, ++k )
+        {
+            int32_t av = a[ i ];
+            while( j < nb && b[ j ] < av ) ++j;
+            bool matched = (k < array_size && (found & (1u << k))) || (j < nb && b[ j ] == av);
+            *dst = av;
+            dst += !matched;
+        }
+        return dst - out;
+    }
+
+    // First position in [first, last) not less than key
+    static const int32_t* gallop( const int32_t* first, const int32_t* last, int32_t key )
+    {
+        size_t size = last - first;
+        if( size == 0 || !(*first < key) )
+            return first;
+
+        // first[lo] < key, first[lo + step] is not or is past the end
+        size_t lo = 0;
+        size_t step = 1;
+        while( lo + step < size && first[ lo + step ] < key )
+        {
+            lo += step;
+            step *= 2;
+        }
+        size_t hi = std::min( lo + step, size );
+        if( lo + 1 == hi )
+            return first + hi;
+        return binary_search::lower_bound< const int32_t*, int32_t, TAG_T >( first + lo + 1,
+                                                                             first + hi, key );
+    }
+
+private:
+    constexpr static uint32_t all_lanes = (1u << array_size) - 1;
+
+    static bool skewed( size_t small, size_t large )
+    {
+        return small * gallop_ratio < large;
+    }
+
+    // Lanes of va with a value anywhere in vb
+    static uint32_t match( simd_type va, simd_type vb )
+    {
+        simd_type ret = equal< int32_t, TAG_T >( va, vb );
+        for( size_t r = 1; r < array_size; ++r )
+        {
+            vb = rotate< int32_t, TAG_T >( vb );
+            ret = mask_or< TAG_T >( ret, equal< int32_t, TAG_T >( va, vb ) );
+        }
+        return lane_mask< int32_t, TAG_T >( ret );
+    }
+
+    // Scalar three way union, repeats of last and between the lists are dropped
+    static int32_t* unite_tail( const int32_t* p, size_t np, const int32_t* a, size_t na,
+                                const int32_t* b, size_t nb, int32_t* dst, bool has_last, int32_t last )
+    {
+        const int32_t* pend = p + np;
+        const int32_t* aend = a + na;
+        const int32_t* bend = b + nb;
+        while( p != pend || a != aend || b != bend )
+        {
+            const int32_t** src = (p != pend) ? &p : ((a != aend) ? &a : &b);
+            if( a != aend && **src > *a ) src = &a;
+            if( b != bend && **src > *b ) src = &b;
+
+            int32_t val = *(*src)++;
+            *dst = val;
+            dst += !has_last || val != last;
+            has_last = true;
+            last = val;
+        }
+        return dst;
+    }
+
+    static size_t gallop_intersect( const int32_t* small, size_t ns,
+                                    const int32_t* large, size_t nl, int32_t* out )
+    {
+        int32_t* dst = out;
+        const int32_t* pos = large;
+        const int32_t* end = large + nl;
+        for( size_t i = 0; i < ns; ++i )
+        {
+            pos = gallop( pos, end, small[ i ] );
+            if( pos == end )
+                break;
+            *dst = small[ i ];
+            dst += (*pos == small[ i ]);
+        }
+        return dst - out;
+    }
+
+    static size_t gallop_unite( const int32_t* small, size_t ns,
+                                const int32_t* large, size_t nl, int32_t* out )
+    {
+        int32_t* dst = out;
+        const int32_t* pos = large;
+        const int32_t* end = large + nl;
+        for( size_t i = 0; i < ns; ++i )
+        {
+            const int32_t* next = gallop( pos, end, small[ i ] );
+            dst = std::copy( pos, next, dst );
+            *dst++ = small[ i ];
+            pos = next + (next != end && *next == small[ i ]);
+        }
+        return std::copy( pos, end, dst ) - out;
+    }
+
+    // a is the small list, values are looked up in b
+    static size_t gallop_subtract_small( const int32_t* a, size_t na,
+                                         const int32_t* b, size_t nb, int32_t* out )
+    {
+        int32_t* dst = out;
+        const int32_t* pos = b;
+        const int32_t* end = b + nb;
+        for( size_t i = 0; i < na; ++i )
+        {
+            pos = gallop( pos, end, a[ i ] );
+            *dst = a[ i ];
+            dst += (pos == end || *pos != a[ i ]);
+        }
+        return dst - out;
+    }
+
+    // b is the small list, the runs of a between its values are copied
+    static size_t gallop_subtract_large( const int32_t* a, size_t na,
+                                         const int32_t* b, size_t nb, int32_t* out )
+    {
+        int32_t* dst = out;
+        const int32_t* pos = a;
+        const int32_t* end = a + na;
+        for( size_t j = 0; j < nb; ++j )
+        {
+            const int32_t* next = gallop( pos, end, b[ j ] );
+            dst = std::copy( pos, next, dst );
+            pos = next + (next != end && *next == b[ j ]);
+        }
+        return std::copy( pos, end, dst ) - out;
+    }
+};
+
+// Container versions, out is replaced by the result and its size is returned
+template< typename TAG_T >
+size_t set_intersection( const aligned_vector< int32_t >& a, const aligned_vector< int32_t >& b,
+                         aligned_vector< int32_t >& out )
+{
+    out.resize( std::min( a.size(), b.size() ) + traits< int32_t, TAG_T >::simd_size );
+    out.resize( set_ops< TAG_T >::intersect( a.data(), a.size(), b.data(), b.size(), out.data() ) );
+    return out.size();
+}
+
+template< typename TAG_T >
+size_t set_union( const aligned_vector< int32_t >& a, const aligned_vector< int32_t >& b,
+                  aligned_vector< int32_t >& out )
+{
+    out.resize( a.size() + b.size() + traits< int32_t, TAG_T >::simd_size );
+    out.resize( set_ops< TAG_T >::unite( a.data(), a.size(), b.data(), b.size(), out.data() ) );
+    return out.size();
+}
+
+template< typename TAG_T >
+size_t set_difference( const aligned_vector< int32_t >& a, const aligned_vector< int32_t >& b,
+                       aligned_vector< int32_t >& out )
+{
+    out.resize( a.size() + traits< int32_t, TAG_T >::simd_size );
+    out.resize( set_ops< TAG_T >::subtract( a.data(), a.size(), b.data(), b.size(), out.data() ) );
+    return out.size();
+}
+
+}} // namespace simd_algorithms::set_algo
+
+#endif // SIMD_ALGORITHMS_SET_ALGO_H
@@ -27,6 +27,7 @@
 #include <x86intrin.h>
 #include <type_traits>
 #include <limits>
+#include <cstring>
 #include <vector>
 #include <string>
 #include <boost/align/aligned_allocator.hpp>
@@ -100,138 +101,823 @@ inline uint32_t mask_to_index( uint32_t mask )
         : (_bit_scan_reverse( mask ) + 1) / sizeof(ValueType_T);
 }
 
+template< typename ValueType_T, typename Tag_T >
+inline uint32_t mask_to_count( uint32_t mask )
+{
+    return _mm_popcnt_u32( mask ) / sizeof(ValueType_T);
+}
+
+// Bit i of the result is the xor of bits 0 to i (carry-less multiply by all ones)
+inline uint64_t prefix_xor( uint64_t mask )
+{
+    return _mm_cvtsi128_si64( _mm_clmulepi64_si128( _mm_set_epi64x( 0, mask ),
+                                                     _mm_set1_epi8( -1 ), 0 ) );
+}
+
 template< typename ValueType_T, typename Tag_T >
 uint32_t result_to_mask( typename traits< ValueType_T, Tag_T >::simd_type )
 {
-    return 0;
+    return 0;
+}
+
+template<> inline uint32_t
+result_to_mask<int32_t, sse_tag>( __m128i retMask )
+{
+    return _mm_movemask_epi8( retMask );
+}
+
+template<> inline uint32_t
+result_to_mask<int32_t, avx_tag>( __m256i retMask )
+{
+    return _mm256_movemask_epi8( retMask );
+}
+
+template<> inline uint32_t
+result_to_mask<char, sse_tag>( __m128i retMask )
+{
+    return _mm_movemask_epi8( retMask );
+}
+
+template<> inline uint32_t
+result_to_mask<char, avx_tag>( __m256i retMask )
+{
+    return _mm256_movemask_epi8( retMask );
+}
+
+template<> inline uint32_t
+result_to_mask<int8_t, sse_tag>( __m128i retMask )
+{
+    return _mm_movemask_epi8( retMask );
+}
+
+template<> inline uint32_t
+result_to_mask<int8_t, avx_tag>( __m256i retMask )
+{
+    return _mm256_movemask_epi8( retMask );
+}
+
+// Lane mask - one bit per lane, taken from the lane sign bit
+// ------------------------------------------------------------------------------------------------
+template< typename ValueType_T, typename Tag_T >
+inline uint32_t lane_mask( typename traits< ValueType_T, Tag_T >::simd_type )
+{
+    return 0;
+}
+
+template<> inline uint32_t
+lane_mask<int32_t, sse_tag>( __m128i retMask )
+{
+    return _mm_movemask_ps( _mm_castsi128_ps( retMask ) );
+}
+
+template<> inline uint32_t
+lane_mask<int32_t, avx_tag>( __m256i retMask )
+{
+    return _mm256_movemask_ps( _mm256_castsi256_ps( retMask ) );
+}
+
+// Unaligned load and store
+// ------------------------------------------------------------------------------------------------
+template< typename ValueType_T, typename Tag_T = sse_tag >
+inline typename traits< ValueType_T, Tag_T >::simd_type
+loadu( const ValueType_T* )
+{
+    return traits< ValueType_T, Tag_T >::zero();
+}
+
+template<> inline __m128i
+loadu< int32_t, sse_tag >( const int32_t* ptr )
+{
+    return _mm_loadu_si128( reinterpret_cast< const __m128i* >( ptr ) );
+}
+
+template<> inline __m256i
+loadu< int32_t, avx_tag >( const int32_t* ptr )
+{
+    return _mm256_loadu_si256( reinterpret_cast< const __m256i* >( ptr ) );
+}
+
+template<> inline __m128i
+loadu< int64_t, sse_tag >( const int64_t* ptr )
+{
+    return _mm_loadu_si128( reinterpret_cast< const __m128i* >( ptr ) );
+}
+
+template<> inline __m256i
+loadu< int64_t, avx_tag >( const int64_t* ptr )
+{
+    return _mm256_loadu_si256( reinterpret_cast< const __m256i* >( ptr ) );
+}
+
+template<> inline __m128i
+loadu< char, sse_tag >( const char* ptr )
+{
+    return _mm_loadu_si128( reinterpret_cast< const __m128i* >( ptr ) );
+}
+
+template<> inline __m256i
+loadu< char, avx_tag >( const char* ptr )
+{
+    return _mm256_loadu_si256( reinterpret_cast< const __m256i* >( ptr ) );
+}
+
+template<> inline __m128i
+loadu< int8_t, sse_tag >( const int8_t* ptr )
+{
+    return _mm_loadu_si128( reinterpret_cast< const __m128i* >( ptr ) );
+}
+
+template<> inline __m256i
+loadu< int8_t, avx_tag >( const int8_t* ptr )
+{
+    return _mm256_loadu_si256( reinterpret_cast< const __m256i* >( ptr ) );
+}
+
+template< typename ValueType_T, typename Tag_T = sse_tag >
+inline void storeu( ValueType_T*, typename traits< ValueType_T, Tag_T >::simd_type )
+{
+}
+
+template<> inline void
+storeu< int32_t, sse_tag >( int32_t* ptr, __m128i val )
+{
+    _mm_storeu_si128( reinterpret_cast< __m128i* >( ptr ), val );
+}
+
+template<> inline void
+storeu< int32_t, avx_tag >( int32_t* ptr, __m256i val )
+{
+    _mm256_storeu_si256( reinterpret_cast< __m256i* >( ptr ), val );
+}
+
+template<> inline void
+storeu< char, sse_tag >( char* ptr, __m128i val )
+{
+    _mm_storeu_si128( reinterpret_cast< __m128i* >( ptr ), val );
+}
+
+template<> inline void
+storeu< char, avx_tag >( char* ptr, __m256i val )
+{
+    _mm256_storeu_si256( reinterpret_cast< __m256i* >( ptr ), val );
+}
+
+// Non-temporal store - aligned, bypasses the cache
+// ------------------------------------------------------------------------------------------------
+template< typename ValueType_T, typename Tag_T = sse_tag >
+inline void store_nt( ValueType_T*, typename traits< ValueType_T, Tag_T >::simd_type )
+{
+}
+
+template<> inline void
+store_nt< char, sse_tag >( char* ptr, __m128i val )
+{
+    _mm_stream_si128( reinterpret_cast< __m128i* >( ptr ), val );
+}
+
+template<> inline void
+store_nt< char, avx_tag >( char* ptr, __m256i val )
+{
+    _mm256_stream_si256( reinterpret_cast< __m256i* >( ptr ), val );
+}
+
+// Decimal value - the last len (<= 16) bytes are ASCII digits, the others are ignored
+// ------------------------------------------------------------------------------------------------
+inline uint64_t decimal_value( __m128i chars, size_t len )
+{
+    __m128i digits = _mm_and_si128( _mm_sub_epi8( chars, _mm_set1_epi8( '0' ) ),
+                                    _mm_cmpgt_epi8( _mm_setr_epi8( 0, 1, 2, 3, 4, 5, 6, 7,
+                                                                   8, 9, 10, 11, 12, 13, 14, 15 ),
+                                                    _mm_set1_epi8( static_cast< char >( 15 - len ) ) ) );
+    // 16 digits -> 8 x 2 -> 4 x 4 -> 2 x 8 digits
+    __m128i pairs = _mm_maddubs_epi16( digits, _mm_setr_epi8( 10, 1, 10, 1, 10, 1, 10, 1,
+                                                              10, 1, 10, 1, 10, 1, 10, 1 ) );
+    __m128i quads = _mm_madd_epi16( pairs, _mm_setr_epi16( 100, 1, 100, 1, 100, 1, 100, 1 ) );
+    __m128i octs = _mm_madd_epi16( _mm_packus_epi32( quads, quads ),
+                                   _mm_setr_epi16( 10000, 1, 10000, 1, 10000, 1, 10000, 1 ) );
+    return static_cast< uint64_t >( _mm_cvtsi128_si32( octs ) ) * 100000000
+         + static_cast< uint32_t >( _mm_extract_epi32( octs, 1 ) );
+}
+
+// Head mask - the first n lanes set
+// ------------------------------------------------------------------------------------------------
+template< typename ValueType_T, typename Tag_T = sse_tag >
+inline typename traits< ValueType_T, Tag_T >::simd_type
+head_mask( size_t )
+{
+    return traits< ValueType_T, Tag_T >::zero();
+}
+
+template<> inline __m128i
+head_mask< char, sse_tag >( size_t n )
+{
+    return _mm_cmpgt_epi8( _mm_set1_epi8( static_cast< char >( n ) ),
+                           _mm_setr_epi8( 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 ) );
+}
+
+template<> inline __m256i
+head_mask< char, avx_tag >( size_t n )
+{
+    return _mm256_cmpgt_epi8( _mm256_set1_epi8( static_cast< char >( n ) ),
+                              _mm256_setr_epi8(  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15,
+                                                16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31 ) );
+}
+
+// Select item
+// ------------------------------------------------------------------------------------------------
+template< typename ValueType_T, typename Tag_T = sse_tag >
+typename traits< ValueType_T, Tag_T >::simd_type
+select( typename traits< ValueType_T, Tag_T >::simd_type lhs, int8_t /*index*/ )
+{
+    return lhs;
+}
+
+template<> inline __m128i
+select<int32_t, sse_tag>( __m128i lhs, int8_t index )
+{
+    int32_t i32 = index << 2;
+    return _mm_shuffle_epi8( lhs, _mm_set_epi8( i32+3, i32+2, i32+1, i32,
+                                                i32+3, i32+2, i32+1, i32,
+                                                i32+3, i32+2, i32+1, i32,
+                                                i32+3, i32+2, i32+1, i32 ) );
+}
+
+template<> inline __m256i
+select<int32_t, avx_tag>( __m256i lhs, int8_t index )
+{
+    return _mm256_permutevar8x32_epi32( lhs, _mm256_set_epi32( index, index, index, index,
+                                                               index, index, index, index  ) );
+}
+
+// Invert bits
+// ------------------------------------------------------------------------------------------------
+template< typename ValueType_T, typename Tag_T = sse_tag >
+typename traits< ValueType_T, Tag_T >::simd_type
+invert( typename traits< ValueType_T, Tag_T >::simd_type lhs )
+{
+    return lhs;
+}
+
+template<> inline __m128i
+invert<int32_t, sse_tag>( __m128i lhs )
+{
+    return _mm_xor_si128( _mm_set1_epi8( 0xff ), lhs );
+}
+
+template<> inline __m256i
+invert<int32_t, avx_tag>( __m256i lhs )
+{
+    return _mm256_xor_si256( _mm256_set1_epi8( 0xff ), lhs );
+}
+
+// iif - Ternary operator
+// ------------------------------------------------------------------------------------------------
+template< typename Tag_T = sse_tag >
+typename traits< int8_t, Tag_T >::simd_type
+iif( typename traits< int8_t, Tag_T >::simd_type mask,
+     typename traits< int8_t, Tag_T >::simd_type /*iftrue*/,
+     typename traits< int8_t, Tag_T >::simd_type /*iffalse*/ )
+{
+    return mask;
+}
+
+template<> inline __m128i
+iif<sse_tag>( __m128i mask, __m128i iftrue, __m128i iffalse )
+{
+    return _mm_blendv_epi8( iffalse, iftrue, mask );
+}
+
+template<> inline __m256i
+iif<avx_tag>( __m256i mask, __m256i iftrue, __m256i iffalse )
+{
+    return _mm256_blendv_epi8( iffalse, iftrue, mask );
+}
+
+// All zero - no bit set in the register
+// ------------------------------------------------------------------------------------------------
+template< typename Tag_T = sse_tag >
+bool all_zero( typename traits< int8_t, Tag_T >::simd_type )
+{
+    return true;
+}
+
+template<> inline bool
+all_zero<sse_tag>( __m128i val )
+{
+    return _mm_testz_si128( val, val ) != 0;
+}
+
+template<> inline bool
+all_zero<avx_tag>( __m256i val )
+{
+    return _mm256_testz_si256( val, val ) != 0;
+}
+
+// Bit AND
+// ------------------------------------------------------------------------------------------------
+template< typename Tag_T = sse_tag >
+typename traits< int8_t, Tag_T >::simd_type
+mask_and( typename traits< int8_t, Tag_T >::simd_type lhs,
+          typename traits< int8_t, Tag_T >::simd_type /*rhs*/ )
+{
+    return lhs;
+}
+
+template<> inline __m128i
+mask_and<sse_tag>( __m128i lhs, __m128i rhs )
+{
+    return _mm_and_si128( lhs, rhs );
+}
+
+template<> inline __m256i
+mask_and<avx_tag>( __m256i lhs, __m256i rhs )
+{
+    return _mm256_and_si256( lhs, rhs );
+}
+
+// Bit OR
+// ------------------------------------------------------------------------------------------------
+template< typename Tag_T = sse_tag >
+typename traits< int8_t, Tag_T >::simd_type
+mask_or( typename traits< int8_t, Tag_T >::simd_type lhs,
+         typename traits< int8_t, Tag_T >::simd_type /*rhs*/ )
+{
+    return lhs;
+}
+
+template<> inline __m128i
+mask_or<sse_tag>( __m128i lhs, __m128i rhs )
+{
+    return _mm_or_si128( lhs, rhs );
+}
+
+template<> inline __m256i
+mask_or<avx_tag>( __m256i lhs, __m256i rhs )
+{
+    return _mm256_or_si256( lhs, rhs );
+}
+
+// Bit XOR
+// ------------------------------------------------------------------------------------------------
+template< typename Tag_T = sse_tag >
+typename traits< int8_t, Tag_T >::simd_type
+mask_xor( typename traits< int8_t, Tag_T >::simd_type lhs,
+          typename traits< int8_t, Tag_T >::simd_type /*rhs*/ )
+{
+    return lhs;
+}
+
+template<> inline __m128i
+mask_xor<sse_tag>( __m128i lhs, __m128i rhs )
+{
+    return _mm_xor_si128( lhs, rhs );
+}
+
+template<> inline __m256i
+mask_xor<avx_tag>( __m256i lhs, __m256i rhs )
+{
+    return _mm256_xor_si256( lhs, rhs );
+}
+
+// Broadcast
+// ------------------------------------------------------------------------------------------------
+template< typename ValueType_T, typename Tag_T = sse_tag >
+typename traits< ValueType_T, Tag_T >::simd_type
+broadcast( ValueType_T )
+{
+    return traits< ValueType_T, Tag_T >::zero();
+}
+
+template<> inline typename traits< char, sse_tag >::simd_type
+broadcast< char, sse_tag >( char val )
+{
+    return _mm_set1_epi8( val );
+}
+
+template<> inline typename traits< char, avx_tag >::simd_type
+broadcast< char, avx_tag >( char val )
+{
+    return _mm256_set1_epi8( val );
+}
+
+template<> inline typename traits< int32_t, sse_tag >::simd_type
+broadcast< int32_t, sse_tag >( int32_t val )
+{
+    return _mm_set1_epi32( val );
+}
+
+template<> inline typename traits< int32_t, avx_tag >::simd_type
+broadcast< int32_t, avx_tag >( int32_t val )
+{
+    return _mm256_set1_epi32( val );
+}
+
+// Add
+// ------------------------------------------------------------------------------------------------
+template< typename ValueType_T, typename Tag_T = sse_tag >
+typename traits< ValueType_T, Tag_T >::simd_type
+add( typename traits< ValueType_T, Tag_T >::simd_type, ValueType_T )
+{
+    return traits< ValueType_T, Tag_T >::zero();
+}
+
+template<> inline typename traits< char, sse_tag >::simd_type
+add< char, sse_tag >( __m128i sval, char val )
+{
+    return _mm_add_epi8( sval, _mm_set1_epi8( val ) );
+}
+
+template<> inline typename traits< char, avx_tag >::simd_type
+add< char, avx_tag >( __m256i sval, char val )
+{
+    return _mm256_add_epi8( sval, _mm256_set1_epi8( val ) );
+}
+
+template<> inline typename traits< int32_t, sse_tag >::simd_type
+add< int32_t, sse_tag >( __m128i sval, int32_t val )
+{
+    return _mm_add_epi32( sval, _mm_set1_epi32( val ) );
+}
+
+template<> inline typename traits< int32_t, avx_tag >::simd_type
+add< int32_t, avx_tag >( __m256i sval, int32_t val )
+{
+    return _mm256_add_epi32( sval, _mm256_set1_epi32( val ) );
+}
+
+
+template< typename ValueType_T, typename Tag_T = sse_tag >
+typename traits< ValueType_T, Tag_T >::simd_type
+add( typename traits< ValueType_T, Tag_T >::simd_type,
+     typename traits< ValueType_T, Tag_T >::simd_type )
+{
+    return traits< ValueType_T, Tag_T >::zero();
+}
+
+template<> inline typename traits< int32_t, sse_tag >::simd_type
+add< int32_t, sse_tag >( __m128i lhs, __m128i rhs )
+{
+    return _mm_add_epi32( lhs, rhs );
+}
+
+template<> inline typename traits< int32_t, avx_tag >::simd_type
+add< int32_t, avx_tag >( __m256i lhs, __m256i rhs )
+{
+    return _mm256_add_epi32( lhs, rhs );
+}
+
+// Widening add - the int32 lanes are sign extended and added to the int64 lanes of acc, the
+// first and second half of the values go to the same accumulator
+// ------------------------------------------------------------------------------------------------
+template< typename ValueType_T, typename Tag_T = sse_tag >
+typename traits< ValueType_T, Tag_T >::simd_type
+widen_add( typename traits< ValueType_T, Tag_T >::simd_type acc,
+           typename traits< ValueType_T, Tag_T >::simd_type )
+{
+    return acc;
+}
+
+template<> inline __m128i
+widen_add< int32_t, sse_tag >( __m128i acc, __m128i val )
+{
+    return _mm_add_epi64( acc, _mm_add_epi64( _mm_cvtepi32_epi64( val ),
+                                              _mm_cvtepi32_epi64( _mm_srli_si128( val, 8 ) ) ) );
+}
+
+template<> inline __m256i
+widen_add< int32_t, avx_tag >( __m256i acc, __m256i val )
+{
+    return _mm256_add_epi64( acc, _mm256_add_epi64( _mm256_cvtepi32_epi64( _mm256_castsi256_si128( val ) ),
+                                                    _mm256_cvtepi32_epi64( _mm256_extracti128_si256( val, 1 ) ) ) );
+}
+
+// Prefix sum - inclusive running sum of the lanes, by shift and add
+// ------------------------------------------------------------------------------------------------
+template< typename ValueType_T, typename Tag_T = sse_tag >
+typename traits< ValueType_T, Tag_T >::simd_type
+prefix_sum( typename traits< ValueType_T, Tag_T >::simd_type val )
+{
+    return val;
+}
+
+template<> inline __m128i
+prefix_sum< int32_t, sse_tag >( __m128i val )
+{
+    val = _mm_add_epi32( val, _mm_slli_si128( val, 4 ) );
+    return _mm_add_epi32( val, _mm_slli_si128( val, 8 ) );
+}
+
+// Each 128 bit half on its own, then the last lane of the low half is added to the high one
+template<> inline __m256i
+prefix_sum< int32_t, avx_tag >( __m256i val )
+{
+    val = _mm256_add_epi32( val, _mm256_slli_si256( val, 4 ) );
+    val = _mm256_add_epi32( val, _mm256_slli_si256( val, 8 ) );
+    return _mm256_add_epi32( val, _mm256_shuffle_epi32( _mm256_permute2x128_si256( val, val, 0x08 ),
+                                                        _MM_SHUFFLE( 3, 3, 3, 3 ) ) );
+}
+
+// Minimum and maximum
+// ------------------------------------------------------------------------------------------------
+template< typename ValueType_T, typename Tag_T = sse_tag >
+typename traits< ValueType_T, Tag_T >::simd_type
+minimum( typename traits< ValueType_T, Tag_T >::simd_type lhs,
+         typename traits< ValueType_T, Tag_T >::simd_type )
+{
+    return lhs;
+}
+
+template<> inline __m128i
+minimum< int32_t, sse_tag >( __m128i lhs, __m128i rhs )
+{
+    return _mm_min_epi32( lhs, rhs );
+}
+
+template<> inline __m256i
+minimum< int32_t, avx_tag >( __m256i lhs, __m256i rhs )
+{
+    return _mm256_min_epi32( lhs, rhs );
+}
+
+template< typename ValueType_T, typename Tag_T = sse_tag >
+typename traits< ValueType_T, Tag_T >::simd_type
+maximum( typename traits< ValueType_T, Tag_T >::simd_type lhs,
+         typename traits< ValueType_T, Tag_T >::simd_type )
+{
+    return lhs;
+}
+
+template<> inline __m128i
+maximum< int32_t, sse_tag >( __m128i lhs, __m128i rhs )
+{
+    return _mm_max_epi32( lhs, rhs );
+}
+
+template<> inline __m256i
+maximum< int32_t, avx_tag >( __m256i lhs, __m256i rhs )
+{
+    return _mm256_max_epi32( lhs, rhs );
+}
+
+// Unsigned saturated add
+// ------------------------------------------------------------------------------------------------
+template< typename ValueType_T, typename Tag_T = sse_tag >
+typename traits< ValueType_T, Tag_T >::simd_type
+saturated_add( typename traits< ValueType_T, Tag_T >::simd_type, ValueType_T )
+{
+    return traits< ValueType_T, Tag_T >::zero();
+}
+
+template<> inline typename traits< char, sse_tag >::simd_type
+saturated_add< char, sse_tag >( __m128i sval, char val )
+{
+    return _mm_adds_epu8( sval, _mm_set1_epi8( val ) );
+}
+
+template<> inline typename traits< char, avx_tag >::simd_type
+saturated_add< char, avx_tag >( __m256i sval, char val )
+{
+    return _mm256_adds_epu8( sval, _mm256_set1_epi8( val ) );
+}
+
+// Unsigned saturated subtract
+// ------------------------------------------------------------------------------------------------
+template< typename ValueType_T, typename Tag_T = sse_tag >
+typename traits< ValueType_T, Tag_T >::simd_type
+saturated_sub( typename traits< ValueType_T, Tag_T >::simd_type, ValueType_T )
+{
+    return traits< ValueType_T, Tag_T >::zero();
+}
+
+template<> inline typename traits< char, sse_tag >::simd_type
+saturated_sub< char, sse_tag >( __m128i sval, char val )
+{
+    return _mm_subs_epu8( sval, _mm_set1_epi8( val ) );
+}
+
+template<> inline typename traits< char, avx_tag >::simd_type
+saturated_sub< char, avx_tag >( __m256i sval, char val )
+{
+    return _mm256_subs_epu8( sval, _mm256_set1_epi8( val ) );
+}
+
+// In range - unsigned lo <= val <= hi
+// ------------------------------------------------------------------------------------------------
+template< typename ValueType_T, typename Tag_T = sse_tag >
+typename traits< ValueType_T, Tag_T >::simd_type
+in_range( typename traits< ValueType_T, Tag_T >::simd_type, ValueType_T, ValueType_T )
+{
+    return traits< ValueType_T, Tag_T >::zero();
+}
+
+template<> inline typename traits< char, sse_tag >::simd_type
+in_range< char, sse_tag >( __m128i val, char lo, char hi )
+{
+    __m128i diff = _mm_sub_epi8( val, _mm_set1_epi8( lo ) );
+    return _mm_cmpeq_epi8( _mm_min_epu8( diff, _mm_set1_epi8( hi - lo ) ), diff );
+}
+
+template<> inline typename traits< char, avx_tag >::simd_type
+in_range< char, avx_tag >( __m256i val, char lo, char hi )
+{
+    __m256i diff = _mm256_sub_epi8( val, _mm256_set1_epi8( lo ) );
+    return _mm256_cmpeq_epi8( _mm256_min_epu8( diff, _mm256_set1_epi8( hi - lo ) ), diff );
+}
+
+// Equal
+// ------------------------------------------------------------------------------------------------
+template< typename ValueType_T, typename Tag_T = sse_tag >
+typename traits< ValueType_T, Tag_T >::simd_type
+equal( typename traits< ValueType_T, Tag_T >::simd_type, ValueType_T )
+{
+    return traits< ValueType_T, Tag_T >::zero();
+}
+
+template<> inline typename traits< char, sse_tag >::simd_type
+equal< char, sse_tag >( __m128i cmp, char key )
+{
+    return _mm_cmpeq_epi8( cmp, _mm_set1_epi8( key ) );
+}
+
+template<> inline typename traits< char, avx_tag >::simd_type
+equal< char, avx_tag >( __m256i cmp, char key )
+{
+    return _mm256_cmpeq_epi8( cmp, _mm256_set1_epi8( key ) );
+}
+
+template< typename ValueType_T, typename Tag_T = sse_tag >
+typename traits< ValueType_T, Tag_T >::simd_type
+equal( typename traits< ValueType_T, Tag_T >::simd_type,
+       typename traits< ValueType_T, Tag_T >::simd_type )
+{
+    return traits< ValueType_T, Tag_T >::zero();
+}
+
+template<> inline typename traits< char, sse_tag >::simd_type
+equal< char, sse_tag >( __m128i lhs, __m128i rhs )
+{
+    return _mm_cmpeq_epi8( lhs, rhs );
+}
+
+template<> inline typename traits< char, avx_tag >::simd_type
+equal< char, avx_tag >( __m256i lhs, __m256i rhs )
+{
+    return _mm256_cmpeq_epi8( lhs, rhs );
+}
+
+template<> inline typename traits< int32_t, sse_tag >::simd_type
+equal< int32_t, sse_tag >( __m128i lhs, __m128i rhs )
+{
+    return _mm_cmpeq_epi32( lhs, rhs );
+}
+
+template<> inline typename traits< int32_t, avx_tag >::simd_type
+equal< int32_t, avx_tag >( __m256i lhs, __m256i rhs )
+{
+    return _mm256_cmpeq_epi32( lhs, rhs );
+}
+
+// Byte lookup - 16 entry table indexed by the low nibble, zero when bit 7 is set (pshufb)
+// ------------------------------------------------------------------------------------------------
+template< typename Tag_T = sse_tag >
+typename traits< char, Tag_T >::simd_type
+lookup_table( const char* /*table16*/ )
+{
+    return traits< char, Tag_T >::zero();
+}
+
+template<> inline __m128i
+lookup_table<sse_tag>( const char* table16 )
+{
+    return _mm_loadu_si128( reinterpret_cast< const __m128i* >( table16 ) );
+}
+
+template<> inline __m256i
+lookup_table<avx_tag>( const char* table16 )
+{
+    return _mm256_broadcastsi128_si256(
+            _mm_loadu_si128( reinterpret_cast< const __m128i* >( table16 ) ) );
+}
+
+template< typename Tag_T = sse_tag >
+typename traits< char, Tag_T >::simd_type
+lookup( typename traits< char, Tag_T >::simd_type table,
+        typename traits< char, Tag_T >::simd_type /*index*/ )
+{
+    return table;
 }
 
-template<> inline uint32_t
-result_to_mask<int32_t, sse_tag>( __m128i retMask )
+template<> inline __m128i
+lookup<sse_tag>( __m128i table, __m128i index )
 {
-    return _mm_movemask_epi8( retMask );
+    return _mm_shuffle_epi8( table, index );
 }
 
-template<> inline uint32_t
-result_to_mask<int32_t, avx_tag>( __m256i retMask )
+template<> inline __m256i
+lookup<avx_tag>( __m256i table, __m256i index )
 {
-    return _mm256_movemask_epi8( retMask );
+    return _mm256_shuffle_epi8( table, index );
 }
 
-// Select item
+// Previous bytes - each byte is replaced by the one N positions before it, the first N come
+// from the end of the previous register
 // ------------------------------------------------------------------------------------------------
-template< typename ValueType_T, typename Tag_T = sse_tag >
-typename traits< ValueType_T, Tag_T >::simd_type
-select( typename traits< ValueType_T, Tag_T >::simd_type lhs, int8_t /*index*/ )
+template< int N_T, typename Tag_T = sse_tag >
+typename traits< char, Tag_T >::simd_type
+prev_bytes( typename traits< char, Tag_T >::simd_type cur,
+            typename traits< char, Tag_T >::simd_type /*prev*/ )
 {
-    return lhs;
+    return cur;
 }
 
 template<> inline __m128i
-select<int32_t, sse_tag>( __m128i lhs, int8_t index )
+prev_bytes<1, sse_tag>( __m128i cur, __m128i prev )
 {
-    int32_t i32 = index << 2;
-    return _mm_shuffle_epi8( lhs, _mm_set_epi8( i32+3, i32+2, i32+1, i32,
-                                                i32+3, i32+2, i32+1, i32,
-                                                i32+3, i32+2, i32+1, i32,
-                                                i32+3, i32+2, i32+1, i32 ) );
+    return _mm_alignr_epi8( cur, prev, 15 );
 }
 
 template<> inline __m256i
-select<int32_t, avx_tag>( __m256i lhs, int8_t index )
+prev_bytes<1, avx_tag>( __m256i cur, __m256i prev )
 {
-    return _mm256_permutevar8x32_epi32( lhs, _mm256_set_epi32( index, index, index, index,
-                                                               index, index, index, index  ) );
+    return _mm256_alignr_epi8( cur, _mm256_permute2x128_si256( prev, cur, 0x21 ), 15 );
 }
 
-// Invert bits
-// ------------------------------------------------------------------------------------------------
-template< typename ValueType_T, typename Tag_T = sse_tag >
-typename traits< ValueType_T, Tag_T >::simd_type
-invert( typename traits< ValueType_T, Tag_T >::simd_type lhs )
+template<> inline __m128i
+prev_bytes<2, sse_tag>( __m128i cur, __m128i prev )
 {
-    return lhs;
+    return _mm_alignr_epi8( cur, prev, 14 );
 }
 
-template<> inline __m128i
-invert<int32_t, sse_tag>( __m128i lhs )
+template<> inline __m256i
+prev_bytes<2, avx_tag>( __m256i cur, __m256i prev )
 {
-    return _mm_xor_si128( _mm_set1_epi8( 0xff ), lhs );
+    return _mm256_alignr_epi8( cur, _mm256_permute2x128_si256( prev, cur, 0x21 ), 14 );
 }
 
-template<> inline __m256i
-invert<int32_t, avx_tag>( __m256i lhs )
+template<> inline __m128i
+prev_bytes<3, sse_tag>( __m128i cur, __m128i prev )
 {
-    return _mm256_xor_si256( _mm256_set1_epi8( 0xff ), lhs );
+    return _mm_alignr_epi8( cur, prev, 13 );
 }
 
-// iif - Ternary operator
-// ------------------------------------------------------------------------------------------------
-template< typename Tag_T = sse_tag >
-typename traits< int8_t, Tag_T >::simd_type
-iif( typename traits< int8_t, Tag_T >::simd_type mask,
-     typename traits< int8_t, Tag_T >::simd_type /*iftrue*/,
-     typename traits< int8_t, Tag_T >::simd_type /*iffalse*/ )
+template<> inline __m256i
+prev_bytes<3, avx_tag>( __m256i cur, __m256i prev )
 {
-    return mask;
+    return _mm256_alignr_epi8( cur, _mm256_permute2x128_si256( prev, cur, 0x21 ), 13 );
 }
 
 template<> inline __m128i
-iif<sse_tag>( __m128i mask, __m128i iftrue, __m128i iffalse )
+prev_bytes<4, sse_tag>( __m128i cur, __m128i prev )
 {
-    return _mm_blendv_epi8( iffalse, iftrue, mask );
+    return _mm_alignr_epi8( cur, prev, 12 );
 }
 
 template<> inline __m256i
-iif<avx_tag>( __m256i mask, __m256i iftrue, __m256i iffalse )
+prev_bytes<4, avx_tag>( __m256i cur, __m256i prev )
 {
-    return _mm256_blendv_epi8( iffalse, iftrue, mask );
+    return _mm256_alignr_epi8( cur, _mm256_permute2x128_si256( prev, cur, 0x21 ), 12 );
 }
 
-// Bit AND
+// Nibbles - high or low 4 bits of each byte, ready to index a lookup
 // ------------------------------------------------------------------------------------------------
 template< typename Tag_T = sse_tag >
-typename traits< int8_t, Tag_T >::simd_type
-mask_and( typename traits< int8_t, Tag_T >::simd_type lhs,
-          typename traits< int8_t, Tag_T >::simd_type /*rhs*/ )
+typename traits< char, Tag_T >::simd_type
+high_nibble( typename traits< char, Tag_T >::simd_type val )
 {
-    return lhs;
+    return val;
 }
 
 template<> inline __m128i
-mask_and<sse_tag>( __m128i lhs, __m128i rhs )
+high_nibble<sse_tag>( __m128i val )
 {
-    return _mm_and_si128( lhs, rhs );
+    return _mm_and_si128( _mm_srli_epi16( val, 4 ), _mm_set1_epi8( 0x0f ) );
 }
 
 template<> inline __m256i
-mask_and<avx_tag>( __m256i lhs, __m256i rhs )
+high_nibble<avx_tag>( __m256i val )
 {
-    return _mm256_and_si256( lhs, rhs );
+    return _mm256_and_si256( _mm256_srli_epi16( val, 4 ), _mm256_set1_epi8( 0x0f ) );
 }
 
-// Add
-// ------------------------------------------------------------------------------------------------
-template< typename ValueType_T, typename Tag_T = sse_tag >
-typename traits< ValueType_T, Tag_T >::simd_type
-add( typename traits< ValueType_T, Tag_T >::simd_type, ValueType_T )
+template< typename Tag_T = sse_tag >
+typename traits< char, Tag_T >::simd_type
+low_nibble( typename traits< char, Tag_T >::simd_type val )
 {
-    return traits< ValueType_T, Tag_T >::zero();
+    return val;
 }
 
-template<> inline typename traits< char, sse_tag >::simd_type
-add< char, sse_tag >( __m128i sval, char val )
+template<> inline __m128i
+low_nibble<sse_tag>( __m128i val )
 {
-    return _mm_add_epi8( sval, _mm_set1_epi8( val ) );
+    return _mm_and_si128( val, _mm_set1_epi8( 0x0f ) );
 }
 
-template<> inline typename traits< char, avx_tag >::simd_type
-add< char, avx_tag >( __m256i sval, char val )
+template<> inline __m256i
+low_nibble<avx_tag>( __m256i val )
 {
-    return _mm256_add_epi8( sval, _mm256_set1_epi8( val ) );
+    return _mm256_and_si256( val, _mm256_set1_epi8( 0x0f ) );
 }
 
-
 // Greater than
 // ------------------------------------------------------------------------------------------------
 template< typename ValueType_T, typename Tag_T = sse_tag >
@@ -325,6 +1011,65 @@ greater_than_mask< int32_t, avx_tag >( int32_t key, __m256i cmp )
     return _mm256_movemask_epi8( _mm256_cmpgt_epi32( _mm256_set1_epi32( key ), cmp ) );
 }
 
+template<> inline uint32_t
+greater_than_mask< int64_t, sse_tag >( int64_t key, __m128i cmp )
+{
+    return _mm_movemask_epi8( _mm_cmpgt_epi64( _mm_set1_epi64x( key ), cmp ) );
+}
+
+template<> inline uint32_t
+greater_than_mask< int64_t, avx_tag >( int64_t key, __m256i cmp )
+{
+    return _mm256_movemask_epi8( _mm256_cmpgt_epi64( _mm256_set1_epi64x( key ), cmp ) );
+}
+
+// Composite greater than mask - lanes where the (major, minor) key is greater than the pair in
+// the two columns, the minor column decides only where the major ones are equal
+// ------------------------------------------------------------------------------------------------
+template< typename ValueType_T, typename Tag_T = sse_tag >
+inline uint32_t composite_greater_than_mask( ValueType_T, ValueType_T,
+                                             typename traits< ValueType_T, Tag_T >::simd_type,
+                                             typename traits< ValueType_T, Tag_T >::simd_type )
+{
+    return 0;
+}
+
+template<> inline uint32_t
+composite_greater_than_mask< int32_t, sse_tag >( int32_t major, int32_t minor, __m128i majors, __m128i minors )
+{
+    __m128i key = _mm_set1_epi32( major );
+    __m128i tie = _mm_and_si128( _mm_cmpeq_epi32( key, majors ), _mm_cmpgt_epi32( _mm_set1_epi32( minor ), minors ) );
+    return _mm_movemask_epi8( _mm_or_si128( _mm_cmpgt_epi32( key, majors ), tie ) );
+}
+
+template<> inline uint32_t
+composite_greater_than_mask< int32_t, avx_tag >( int32_t major, int32_t minor, __m256i majors, __m256i minors )
+{
+    __m256i key = _mm256_set1_epi32( major );
+    __m256i tie = _mm256_and_si256( _mm256_cmpeq_epi32( key, majors ), _mm256_cmpgt_epi32( _mm256_set1_epi32( minor ), minors ) );
+    return _mm256_movemask_epi8( _mm256_or_si256( _mm256_cmpgt_epi32( key, majors ), tie ) );
+}
+
+// Less than mask
+// ------------------------------------------------------------------------------------------------
+template< typename ValueType_T, typename Tag_T = sse_tag >
+inline uint32_t less_than_mask( ValueType_T, typename traits< ValueType_T, Tag_T >::simd_type )
+{
+    return 0;
+}
+
+template<> inline uint32_t
+less_than_mask< int32_t, sse_tag >( int32_t key, __m128i cmp )
+{
+    return _mm_movemask_epi8( _mm_cmpgt_epi32( cmp, _mm_set1_epi32( key ) ) );
+}
+
+template<> inline uint32_t
+less_than_mask< int32_t, avx_tag >( int32_t key, __m256i cmp )
+{
+    return _mm256_movemask_epi8( _mm256_cmpgt_epi32( cmp, _mm256_set1_epi32( key ) ) );
+}
+
 // Mask to index
 // ------------------------------------------------------------------------------------------------
 template< typename ValueType_T, typename Tag_T = sse_tag >
@@ -355,6 +1100,18 @@ equal_mask< int32_t, avx_tag >( int32_t key, __m256i cmp )
     return _mm256_movemask_epi8( _mm256_cmpeq_epi32( _mm256_set1_epi32( key ), cmp ) );
 }
 
+template<> inline uint32_t
+equal_mask< int8_t, sse_tag >( int8_t key, __m128i cmp )
+{
+    return _mm_movemask_epi8( _mm_cmpeq_epi8( _mm_set1_epi8( key ), cmp ) );
+}
+
+template<> inline uint32_t
+equal_mask< int8_t, avx_tag >( int8_t key, __m256i cmp )
+{
+    return _mm256_movemask_epi8( _mm256_cmpeq_epi8( _mm256_set1_epi8( key ), cmp ) );
+}
+
 // Equal index
 // ------------------------------------------------------------------------------------------------
 template< typename ValueType_T, typename Tag_T = sse_tag >
@@ -365,6 +1122,50 @@ inline uint32_t equal_index( ValueType_T val,
             equal_mask< ValueType_T, Tag_T >( val, simdVal ) ) - 1;
 }
 
+// Compare bytes - memcmp, a register at a time, the bytes past the last full register one by one
+// ------------------------------------------------------------------------------------------------
+template< typename Tag_T = sse_tag >
+inline int compare_bytes( const char* lhs, const char* rhs, size_t len )
+{
+    return std::memcmp( lhs, rhs, len );
+}
+
+template<> inline int
+compare_bytes< sse_tag >( const char* lhs, const char* rhs, size_t len )
+{
+    size_t i = 0;
+    for( ; i + 16 <= len; i += 16 )
+    {
+        uint32_t diff = 0xffff ^ _mm_movemask_epi8( _mm_cmpeq_epi8(
+                            _mm_loadu_si128( reinterpret_cast< const __m128i* >( lhs + i ) ),
+                            _mm_loadu_si128( reinterpret_cast< const __m128i* >( rhs + i ) ) ) );
+        if( diff != 0 )
+        {
+            i += _bit_scan_forward( diff );
+            return static_cast< uint8_t >( lhs[ i ] ) - static_cast< uint8_t >( rhs[ i ] );
+        }
+    }
+    return std::memcmp( lhs + i, rhs + i, len - i );
+}
+
+template<> inline int
+compare_bytes< avx_tag >( const char* lhs, const char* rhs, size_t len )
+{
+    size_t i = 0;
+    for( ; i + 32 <= len; i += 32 )
+    {
+        uint32_t diff = ~static_cast< uint32_t >( _mm256_movemask_epi8( _mm256_cmpeq_epi8(
+                            _mm256_loadu_si256( reinterpret_cast< const __m256i* >( lhs + i ) ),
+                            _mm256_loadu_si256( reinterpret_cast< const __m256i* >( rhs + i ) ) ) ) );
+        if( diff != 0 )
+        {
+            i += _bit_scan_forward( diff );
+            return static_cast< uint8_t >( lhs[ i ] ) - static_cast< uint8_t >( rhs[ i ] );
+        }
+    }
+    return compare_bytes< sse_tag >( lhs + i, rhs + i, len - i );
+}
+
 // Low insert
 // ------------------------------------------------------------------------------------------------
 template< typename ValueType_T, typename Tag_T = sse_tag >
@@ -387,6 +1188,257 @@ high_insert< int32_t, avx_tag >( __m256i vec, int32_t val )
                                 val, 7 );
 }
 
+// Multiply - low 32 bits of each lane product
+// ------------------------------------------------------------------------------------------------
+template< typename ValueType_T, typename Tag_T = sse_tag >
+inline typename traits< ValueType_T, Tag_T >::simd_type
+multiply( typename traits< ValueType_T, Tag_T >::simd_type lhs,
+          typename traits< ValueType_T, Tag_T >::simd_type )
+{
+    return lhs;
+}
+
+template<> inline __m128i
+multiply< int32_t, sse_tag >( __m128i lhs, __m128i rhs )
+{
+    return _mm_mullo_epi32( lhs, rhs );
+}
+
+template<> inline __m256i
+multiply< int32_t, avx_tag >( __m256i lhs, __m256i rhs )
+{
+    return _mm256_mullo_epi32( lhs, rhs );
+}
+
+// Shift right - logical, every lane by the same count
+// ------------------------------------------------------------------------------------------------
+template< typename ValueType_T, typename Tag_T = sse_tag >
+inline typename traits< ValueType_T, Tag_T >::simd_type
+shift_right( typename traits< ValueType_T, Tag_T >::simd_type vec, int )
+{
+    return vec;
+}
+
+template<> inline __m128i
+shift_right< int32_t, sse_tag >( __m128i vec, int count )
+{
+    return _mm_srli_epi32( vec, count );
+}
+
+template<> inline __m256i
+shift_right< int32_t, avx_tag >( __m256i vec, int count )
+{
+    return _mm256_srli_epi32( vec, count );
+}
+
+// Shift left - every lane by the same count
+// ------------------------------------------------------------------------------------------------
+template< typename ValueType_T, typename Tag_T = sse_tag >
+inline typename traits< ValueType_T, Tag_T >::simd_type
+shift_left( typename traits< ValueType_T, Tag_T >::simd_type vec, int )
+{
+    return vec;
+}
+
+template<> inline __m128i
+shift_left< int32_t, sse_tag >( __m128i vec, int count )
+{
+    return _mm_slli_epi32( vec, count );
+}
+
+template<> inline __m256i
+shift_left< int32_t, avx_tag >( __m256i vec, int count )
+{
+    return _mm256_slli_epi32( vec, count );
+}
+
+// Lane bit - 1 << shift in each lane, shifts from 0 to 31
+// ------------------------------------------------------------------------------------------------
+template< typename ValueType_T, typename Tag_T = sse_tag >
+inline typename traits< ValueType_T, Tag_T >::simd_type
+lane_bit( typename traits< ValueType_T, Tag_T >::simd_type shift )
+{
+    return shift;
+}
+
+// SSE has no variable shift. The shift goes to the exponent of the float 1.0, which is 2^shift
+// once converted back; 2^31 is out of range and converts to 0x80000000, the right bit too
+template<> inline __m128i
+lane_bit< int32_t, sse_tag >( __m128i shift )
+{
+    return _mm_cvttps_epi32( _mm_castsi128_ps(
+               _mm_add_epi32( _mm_slli_epi32( shift, 23 ), _mm_set1_epi32( 0x3f800000 ) ) ) );
+}
+
+template<> inline __m256i
+lane_bit< int32_t, avx_tag >( __m256i shift )
+{
+    return _mm256_sllv_epi32( _mm256_set1_epi32( 1 ), shift );
+}
+
+// All bits set - every bit of bits is also set in vec
+// ------------------------------------------------------------------------------------------------
+template< typename Tag_T = sse_tag >
+inline bool all_bits_set( typename traits< int8_t, Tag_T >::simd_type,
+                          typename traits< int8_t, Tag_T >::simd_type )
+{
+    return false;
+}
+
+template<> inline bool
+all_bits_set< sse_tag >( __m128i vec, __m128i bits )
+{
+    return _mm_testc_si128( vec, bits );
+}
+
+template<> inline bool
+all_bits_set< avx_tag >( __m256i vec, __m256i bits )
+{
+    return _mm256_testc_si256( vec, bits );
+}
+
+// Rotate - each lane is replaced by the next one, the first lane goes to the last
+// ------------------------------------------------------------------------------------------------
+template< typename ValueType_T, typename Tag_T = sse_tag >
+inline typename traits< ValueType_T, Tag_T >::simd_type
+rotate( typename traits< ValueType_T, Tag_T >::simd_type vec )
+{
+    return vec;
+}
+
+template<> inline __m128i
+rotate< int32_t, sse_tag >( __m128i vec )
+{
+    return _mm_shuffle_epi32( vec, _MM_SHUFFLE( 0, 3, 2, 1 ) );
+}
+
+template<> inline __m256i
+rotate< int32_t, avx_tag >( __m256i vec )
+{
+    return _mm256_permutevar8x32_epi32( vec, _mm256_set_epi32( 0, 7, 6, 5, 4, 3, 2, 1 ) );
+}
+
+// Compress - the lanes set in a lane mask are packed to the front, the remaining lanes are
+// undefined. The permute control comes from a table with one entry per mask
+// ------------------------------------------------------------------------------------------------
+template< size_t Lanes_T, size_t LaneBytes_T >
+struct compress_table
+{
+    constexpr compress_table() : index()
+    {
+        for( size_t mask = 0; mask < (1u << Lanes_T); ++mask )
+        {
+            size_t pos = 0;
+            for( size_t lane = 0; lane < Lanes_T; ++lane )
+            {
+                if( mask & (1u << lane) )
+                {
+                    for( size_t byte = 0; byte < LaneBytes_T; ++byte )
+                    {
+                        index[ mask ][ pos * LaneBytes_T + byte ] =
+                            static_cast< uint8_t >( lane * LaneBytes_T + byte );
+                    }
+                    ++pos;
+                }
+            }
+        }
+    }
+
+    static const compress_table value;
+
+    alignas( 16 ) uint8_t index[ 1u << Lanes_T ][ Lanes_T * LaneBytes_T ];
+};
+
+template< size_t Lanes_T, size_t LaneBytes_T >
+const compress_table< Lanes_T, LaneBytes_T > compress_table< Lanes_T, LaneBytes_T >::value;
+
+template< typename ValueType_T, typename Tag_T = sse_tag >
+inline typename traits< ValueType_T, Tag_T >::simd_type
+compress( typename traits< ValueType_T, Tag_T >::simd_type vec, uint32_t /*mask*/ )
+{
+    return vec;
+}
+
+// pshufb, the table holds byte indexes
+template<> inline __m128i
+compress< int32_t, sse_tag >( __m128i vec, uint32_t mask )
+{
+    return _mm_shuffle_epi8( vec, _mm_load_si128( reinterpret_cast< const __m128i* >(
+                                      compress_table< 4, 4 >::value.index[ mask ] ) ) );
+}
+
+// vpermd, the table holds lane indexes. AVX-512 has the instruction (vpcompressd)
+template<> inline __m256i
+compress< int32_t, avx_tag >( __m256i vec, uint32_t mask )
+{
+#ifdef __AVX512VL__
+    return _mm256_maskz_compress_epi32( static_cast< __mmask8 >( mask ), vec );
+#else
+    return _mm256_permutevar8x32_epi32( vec, _mm256_cvtepu8_epi32( _mm_loadl_epi64(
+                                        reinterpret_cast< const __m128i* >(
+                                            compress_table< 8, 1 >::value.index[ mask ] ) ) ) );
+#endif
+}
+
+// Bitonic merge - lo and hi are sorted on input, on output lo has the smallest half of both
+// and hi the largest, each sorted
+// ------------------------------------------------------------------------------------------------
+template< typename ValueType_T, typename Tag_T = sse_tag >
+inline void bitonic_merge( typename traits< ValueType_T, Tag_T >::simd_type& /*lo*/,
+                           typename traits< ValueType_T, Tag_T >::simd_type& /*hi*/ )
+{
+}
+
+template<> inline void
+bitonic_merge< int32_t, sse_tag >( __m128i& lo, __m128i& hi )
+{
+    // Reversing hi makes lo:hi bitonic, then compare distances 4, 2 and 1
+    __m128i rev = _mm_shuffle_epi32( hi, _MM_SHUFFLE( 0, 1, 2, 3 ) );
+    __m128i l = _mm_min_epi32( lo, rev );
+    __m128i h = _mm_max_epi32( lo, rev );
+
+    __m128i t0 = _mm_unpacklo_epi64( l, h );
+    __m128i t1 = _mm_unpackhi_epi64( l, h );
+    __m128i mn = _mm_min_epi32( t0, t1 );
+    __m128i mx = _mm_max_epi32( t0, t1 );
+
+    t0 = _mm_unpacklo_epi32( mn, mx );
+    t1 = _mm_unpackhi_epi32( mn, mx );
+    __m128i a = _mm_unpacklo_epi64( t0, t1 );
+    __m128i b = _mm_unpackhi_epi64( t0, t1 );
+    mn = _mm_min_epi32( a, b );
+    mx = _mm_max_epi32( a, b );
+
+    lo = _mm_unpacklo_epi32( mn, mx );
+    hi = _mm_unpackhi_epi32( mn, mx );
+}
+
+template<> inline void
+bitonic_merge< int32_t, avx_tag >( __m256i& lo, __m256i& hi )
+{
+    __m256i rev = _mm256_permutevar8x32_epi32( hi, _mm256_set_epi32( 0, 1, 2, 3, 4, 5, 6, 7 ) );
+    __m256i l = _mm256_min_epi32( lo, rev );
+    __m256i h = _mm256_max_epi32( lo, rev );
+
+    // Distance 4, lane i against lane i ^ 4
+    __m256i pl = _mm256_permute2x128_si256( l, l, 0x01 );
+    __m256i ph = _mm256_permute2x128_si256( h, h, 0x01 );
+    l = _mm256_blend_epi32( _mm256_min_epi32( l, pl ), _mm256_max_epi32( l, pl ), 0xf0 );
+    h = _mm256_blend_epi32( _mm256_min_epi32( h, ph ), _mm256_max_epi32( h, ph ), 0xf0 );
+
+    // Distance 2
+    pl = _mm256_shuffle_epi32( l, _MM_SHUFFLE( 1, 0, 3, 2 ) );
+    ph = _mm256_shuffle_epi32( h, _MM_SHUFFLE( 1, 0, 3, 2 ) );
+    l = _mm256_blend_epi32( _mm256_min_epi32( l, pl ), _mm256_max_epi32( l, pl ), 0xcc );
+    h = _mm256_blend_epi32( _mm256_min_epi32( h, ph ), _mm256_max_epi32( h, ph ), 0xcc );
+
+    // Distance 1
+    pl = _mm256_shuffle_epi32( l, _MM_SHUFFLE( 2, 3, 0, 1 ) );
+    ph = _mm256_shuffle_epi32( h, _MM_SHUFFLE( 2, 3, 0, 1 ) );
+    lo = _mm256_blend_epi32( _mm256_min_epi32( l, pl ), _mm256_max_epi32( l, pl ), 0xaa );
+    hi = _mm256_blend_epi32( _mm256_min_epi32( h, ph ), _mm256_max_epi32( h, ph ), 0xaa );
+}
+
 } //namespace simd_algorithms
 
 #endif // SIMD_ALGORITHMS_BINARY_SEARCH_H
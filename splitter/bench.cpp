@@ -0,0 +1,148 @@
+// MIT License
+//
+// Copyright (c) 2018 André Tupinambá
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "splitter.h"
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <numeric>
+#include <vector>
+#include <boost/timer/timer.hpp>
+
+bool g_verbose = true;
+namespace sa = simd_algorithms;
+
+void do_nothing( const sa::aligned_string& );
+void do_nothing( size_t );
+
+// Byte at a time state machine with the same output
+struct scalar_splitter
+{
+    bool in_quote = false;
+
+    size_t operator()( const char* data, size_t size, uint32_t* offsets )
+    {
+        uint32_t* out = offsets;
+        for( size_t i = 0; i < size; ++i )
+        {
+            char ch = data[i];
+            if( ch == '"' )
+                in_quote = !in_quote;
+            else if( !in_quote && (ch == ',' || ch == '\n') )
+                *out++ = i;
+        }
+        return out - offsets;
+    }
+};
+
+template< typename TAG_T >
+struct simd_splitter : sa::string_algo::splitter< TAG_T >
+{
+};
+
+// Records of numbers, words and quoted text with commas and newlines inside
+sa::aligned_string make_csv( size_t size )
+{
+    static const char* fields[] = { "12345", "john", "\"Smith, John\"", "0.5", "",
+                                    "\"multi\nline\"", "2018-06-01", "\"say \"\"hi\"\"\"" };
+    sa::aligned_string ret;
+    srand(1);
+    while( ret.size() < size )
+    {
+        for( int f = 0; f < 6; ++f )
+        {
+            ret += fields[ rand() % 8 ];
+            ret += (f < 5) ? "," : "\n";
+        }
+    }
+    ret.resize( size );
+    return ret;
+}
+
+template< typename SPLIT_T >
+uint64_t bench( const std::string& name, const sa::aligned_string& text, size_t loop )
+{
+    boost::timer::cpu_timer timer;
+    std::vector< uint32_t > offsets( sa::string_algo::splitter< sa::sse_tag >::capacity( text.size() ) );
+
+    timer.start();
+    for( size_t j = 0; j < loop; ++j )
+    {
+        SPLIT_T split;
+        do_nothing( split( text.data(), text.size(), offsets.data() ) );
+    }
+    timer.stop();
+    if( g_verbose )
+        std::cout << "Split " << name << ": " << timer.format();
+
+    return timer.elapsed().wall;
+}
+
+int main(int argc, char* /*argv*/[])
+{
+    constexpr size_t runSize = 0x00100001;
+    constexpr size_t loop = 1000;
+    if( argc > 1 )
+    {
+        g_verbose = false;
+        std::cout << "count,base,sse,avx" << std::endl;
+    }
+    else
+    {
+        std::cout << "\nsize: 0x" << std::hex << std::setw(8) << std::setfill( '0') << runSize << std::endl << std::endl;
+    }
+
+    sa::aligned_string text = make_csv( runSize );
+    size_t cnt = 0;
+    while( 1 )
+    {
+        uint64_t base = bench< scalar_splitter >( "Scalar", text, loop );
+        uint64_t sse = bench< simd_splitter< sa::sse_tag > >( "SSE ..", text, loop );
+        uint64_t avx = bench< simd_splitter< sa::avx_tag > >( "AVX ..", text, loop );
+
+        if( g_verbose )
+        {
+            std::cout
+                      << std::endl << "Speed up SSE.......: " << std::fixed << std::setprecision(2)
+                      << static_cast<float>(base)/static_cast<float>(sse) << "x"
+
+                      << std::endl << "Speed up AVX.......: " << std::fixed << std::setprecision(2)
+                      << static_cast<float>(base)/static_cast<float>(avx) << "x"
+
+                      << std::endl << "AVX GB/s...........: " << std::fixed << std::setprecision(2)
+                      << static_cast<float>(runSize * loop)/static_cast<float>(avx)
+
+                      << std::endl << std::endl;
+        }
+        else
+        {
+            std::cout
+                << ++cnt << ","
+                << base << ","
+                << sse << ","
+                << avx
+                << std::endl;
+        }
+    }
+    return 0;
+}
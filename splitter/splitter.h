@@ -0,0 +1,179 @@
+// MIT License
+//
+// Copyright (c) 2018 André Tupinambá
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef SIMD_ALGORITHMS_SPLITTER_H
+#define SIMD_ALGORITHMS_SPLITTER_H
+
+#include <cstring>
+#include <boost/utility/string_view.hpp>
+#include "../simd_compare.h"
+
+namespace simd_algorithms{
+namespace string_algo{
+
+// Field splitter for delimiter separated records (CSV, TSV) and whitespace separated text.
+// Input is classified 64 bytes at a time into bit sets and the offsets are written from the
+// set bits, so there is no branch per byte and no allocation per field.
+//
+// Delimited mode writes the offset of every delimiter and newline that is not inside quotes;
+// the caller tells them apart by the byte at the offset. Whitespace mode writes the offset of
+// every transition between whitespace and non whitespace, so fields are [start, end) pairs
+// taken in order; a field still open at the end of the stream has no end offset.
+//
+// A stream can be split in chunks of any size, the quote and whitespace state is kept from
+// one call to the next. Offsets are relative to the data of each call.
+template< typename TAG_T >
+class splitter
+{
+public:
+    using simd_type = typename traits< char, TAG_T >::simd_type;
+    constexpr static size_t array_size = traits< char, TAG_T >::simd_size;
+    constexpr static size_t block_size = 64;
+
+    splitter( char delimiter = ',', char quote = '"' )
+        : whitespace_( false ), delimiter_( delimiter ), quote_( quote ){}
+
+    static splitter whitespace()
+    {
+        splitter ret;
+        ret.whitespace_ = true;
+        return ret;
+    }
+
+    // Entries the offsets array must have for size bytes, a few more than size as offsets are
+    // written in groups
+    static size_t capacity( size_t size )
+    {
+        return size + 8;
+    }
+
+    size_t operator()( const char* data, size_t size, uint32_t* offsets )
+    {
+        uint32_t* out = offsets;
+        size_t i = 0;
+        for( ; i + block_size <= size; i += block_size )
+        {
+            out = emit( out, i, block( data + i ) );
+        }
+
+        if( i < size )
+        {
+            // Zero padded copy of the last bytes, the padding bits are dropped
+            alignas( 64 ) char tail[ block_size ] = {};
+            size_t len = size - i;
+            std::memcpy( tail, data + i, len );
+            out = emit( out, i, block( tail, len ) );
+        }
+        return out - offsets;
+    }
+
+    size_t operator()( boost::string_view str, uint32_t* offsets )
+    {
+        return (*this)( str.data(), str.size(), offsets );
+    }
+
+    // Back to the start of a stream
+    void reset()
+    {
+        in_quote_ = 0;
+        prev_space_ = 1;
+    }
+
+    bool in_quote() const
+    {
+        return in_quote_ != 0;
+    }
+
+private:
+    bool whitespace_;
+    char delimiter_;
+    char quote_;
+    uint64_t in_quote_ = 0;     // All ones while inside quotes
+    uint64_t prev_space_ = 1;   // Last byte seen was whitespace
+
+    uint64_t block( const char* ptr, size_t len = block_size )
+    {
+        uint64_t valid = (len == block_size) ? ~0ULL : (1ULL << len) - 1;
+        return whitespace_ ? space_transitions( ptr, len, valid ) : separators( ptr, valid );
+    }
+
+    uint64_t separators( const char* ptr, uint64_t valid )
+    {
+        uint64_t quotes = 0;
+        uint64_t seps = 0;
+        for( size_t j = 0; j < block_size; j += array_size )
+        {
+            simd_type data = loadu< char, TAG_T >( ptr + j );
+            quotes |= static_cast< uint64_t >(
+                result_to_mask< char, TAG_T >( equal< char, TAG_T >( data, quote_ ) ) ) << j;
+            seps |= static_cast< uint64_t >(
+                result_to_mask< char, TAG_T >( mask_or< TAG_T >( equal< char, TAG_T >( data, delimiter_ ),
+                                                                 equal< char, TAG_T >( data, '\n' ) ) ) ) << j;
+        }
+
+        // Bits from an opening quote up to its closing one, "" inside quotes toggles twice
+        uint64_t inside = prefix_xor( quotes & valid ) ^ in_quote_;
+        in_quote_ = static_cast< uint64_t >( static_cast< int64_t >( inside ) >> 63 );
+        return seps & ~inside & valid;
+    }
+
+    uint64_t space_transitions( const char* ptr, size_t len, uint64_t valid )
+    {
+        // Whitespace bytes are the ones equal to the table entry for their low nibble
+        alignas( 16 ) static const char table[16] = { ' ', 0, 0, 0, 0, 0, 0, 0,
+                                                      0, '\t', '\n', '\v', '\f', '\r', 0, 0 };
+        simd_type lut = lookup_table< TAG_T >( table );
+
+        uint64_t space = 0;
+        for( size_t j = 0; j < block_size; j += array_size )
+        {
+            simd_type data = loadu< char, TAG_T >( ptr + j );
+            space |= static_cast< uint64_t >(
+                result_to_mask< char, TAG_T >( equal< char, TAG_T >( lookup< TAG_T >( lut, data ), data ) ) ) << j;
+        }
+
+        uint64_t transitions = (space ^ ((space << 1) | prev_space_)) & valid;
+        prev_space_ = (space >> (len - 1)) & 1;
+        return transitions;
+    }
+
+    // Writes base + index of each set bit, eight at a time
+    static uint32_t* emit( uint32_t* out, size_t base, uint64_t mask )
+    {
+        uint32_t* end = out + _mm_popcnt_u64( mask );
+        uint32_t offset = static_cast< uint32_t >( base );
+        while( out < end )
+        {
+            for( size_t k = 0; k < 8; ++k )
+            {
+                out[k] = offset + static_cast< uint32_t >( _tzcnt_u64( mask ) );
+                mask = _blsr_u64( mask );
+            }
+            out += 8;
+        }
+        return end;
+    }
+};
+
+}} // namespace simd_algorithms::string_algo
+
+#endif // SIMD_ALGORITHMS_SPLITTER_H
@@ -0,0 +1,169 @@
+// MIT License
+//
+// Copyright (c) 2018 André Tupinambá
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "stream_transform.h"
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <numeric>
+#include <boost/filesystem.hpp>
+#include <boost/timer/timer.hpp>
+
+bool g_verbose = true;
+namespace sa = simd_algorithms;
+namespace fs = boost::filesystem;
+
+void do_nothing( const sa::aligned_string& );
+
+void write_text( const fs::path& name, size_t size )
+{
+    sa::aligned_string text( size, ' ' );
+    srand(1);
+    std::generate( text.begin(), text.end(), []{ return static_cast< char >( 0x20 + rand() % 0x5f ); } );
+    FILE* out = fopen( name.c_str(), "wb" );
+    fwrite( text.data(), 1, text.size(), out );
+    fclose( out );
+}
+
+// Single threaded read, to_lower and write of the whole file
+template< typename TAG_T >
+uint64_t bench_naive( const std::string& name, const fs::path& input, const fs::path& output,
+                      size_t size, size_t loop )
+{
+    boost::timer::cpu_timer timer;
+    sa::string_algo::to_lower< TAG_T > toLower;
+
+    timer.start();
+    for( size_t j = 0; j < loop; ++j )
+    {
+        sa::aligned_string text( size, ' ' );
+        FILE* in = fopen( input.c_str(), "rb" );
+        text.resize( fread( (char*) text.data(), 1, text.size(), in ) );
+        fclose( in );
+        toLower( text );
+        FILE* out = fopen( output.c_str(), "wb" );
+        fwrite( text.data(), 1, text.size(), out );
+        fclose( out );
+        do_nothing( text );
+    }
+    timer.stop();
+    if( g_verbose )
+        std::cout << "To lower " << name << ": " << timer.format();
+
+    return timer.elapsed().wall;
+}
+
+template< typename TAG_T >
+uint64_t bench_file( const std::string& name, const fs::path& input, const fs::path& output,
+                     size_t loop, size_t threads )
+{
+    boost::timer::cpu_timer timer;
+    sa::string_algo::stream_transform< sa::string_algo::to_lower< TAG_T > > stream( threads );
+
+    timer.start();
+    for( size_t j = 0; j < loop; ++j )
+    {
+        stream( input.string(), output.string() );
+    }
+    timer.stop();
+    if( g_verbose )
+        std::cout << "To lower " << name << ": " << timer.format();
+
+    return timer.elapsed().wall;
+}
+
+template< typename TAG_T >
+uint64_t bench_fd( const std::string& name, const fs::path& input, const fs::path& output,
+                   size_t loop, size_t threads )
+{
+    boost::timer::cpu_timer timer;
+    sa::string_algo::stream_transform< sa::string_algo::to_lower< TAG_T > > stream( threads );
+
+    timer.start();
+    for( size_t j = 0; j < loop; ++j )
+    {
+        int in = open( input.c_str(), O_RDONLY );
+        int out = open( output.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644 );
+        stream( in, out );
+        close( in );
+        close( out );
+    }
+    timer.stop();
+    if( g_verbose )
+        std::cout << "To lower " << name << ": " << timer.format();
+
+    return timer.elapsed().wall;
+}
+
+int main(int argc, char* /*argv*/[])
+{
+    constexpr size_t runSize = 0x10000000;
+    constexpr size_t loop = 4;
+    size_t threads = std::max( 1u, std::thread::hardware_concurrency() );
+    if( argc > 1 )
+    {
+        g_verbose = false;
+        std::cout << "count,naive,mmap,fd" << std::endl;
+    }
+    else
+    {
+        std::cout << "\nsize: 0x" << std::hex << std::setw(8) << std::setfill( '0') << runSize
+                  << std::dec << ", threads: " << threads << std::endl << std::endl;
+    }
+
+    fs::path input = fs::temp_directory_path() / fs::unique_path();
+    fs::path output = fs::temp_directory_path() / fs::unique_path();
+    write_text( input, runSize );
+
+    size_t cnt = 0;
+    while( 1 )
+    {
+        uint64_t base = bench_naive< sa::avx_tag >( "naive AVX .....", input, output, runSize, loop );
+        uint64_t file = bench_file< sa::avx_tag >( "mmap AVX ......", input, output, loop, threads );
+        uint64_t fd = bench_fd< sa::avx_tag >( "fd AVX ........", input, output, loop, threads );
+
+        if( g_verbose )
+        {
+            bench_file< sa::sse_tag >( "mmap SSE ......", input, output, loop, threads );
+            bench_file< sa::avx_tag >( "mmap AVX 1 thr ", input, output, loop, 1 );
+            bench_fd< sa::avx_tag >( "fd AVX 1 thr ..", input, output, loop, 1 );
+            std::cout
+                << std::endl << "Speed up mmap ....: " << std::fixed << std::setprecision(2)
+                << static_cast<float>(base)/static_cast<float>(file) << "x"
+                << std::endl << "Speed up fd ......: " << std::fixed << std::setprecision(2)
+                << static_cast<float>(base)/static_cast<float>(fd) << "x"
+
+                << std::endl << std::endl;
+        }
+        else
+        {
+            std::cout
+                << ++cnt << ","
+                << base << ","
+                << file << ","
+                << fd
+                << std::endl;
+        }
+    }
+    return 0;
+}
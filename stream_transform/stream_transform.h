@@ -0,0 +1,308 @@
+// MIT License
+//
+// Copyright (c) 2018 André Tupinambá
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef SIMD_ALGORITHMS_STREAM_TRANSFORM_H
+#define SIMD_ALGORITHMS_STREAM_TRANSFORM_H
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+#include "../simd_compare.h"
+#include "../to_lower/to_lower.h"
+
+namespace simd_algorithms{
+namespace string_algo{
+
+// Fixed set of threads running queued tasks
+class worker_pool
+{
+public:
+    worker_pool( size_t threads )
+    {
+        for( size_t i = 0; i < threads; ++i )
+        {
+            workers_.emplace_back( [this]{ work(); } );
+        }
+    }
+
+    ~worker_pool()
+    {
+        {
+            std::lock_guard< std::mutex > lock( mutex_ );
+            stop_ = true;
+        }
+        cond_.notify_all();
+        for( auto&& worker : workers_ )
+        {
+            worker.join();
+        }
+    }
+
+    std::future< void > submit( std::function< void() > task )
+    {
+        std::packaged_task< void() > job( std::move( task ) );
+        std::future< void > ret = job.get_future();
+        {
+            std::lock_guard< std::mutex > lock( mutex_ );
+            tasks_.push( std::move( job ) );
+        }
+        cond_.notify_one();
+        return ret;
+    }
+
+private:
+    std::vector< std::thread > workers_;
+    std::queue< std::packaged_task< void() > > tasks_;
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    bool stop_ = false;
+
+    void work()
+    {
+        while( true )
+        {
+            std::packaged_task< void() > job;
+            {
+                std::unique_lock< std::mutex > lock( mutex_ );
+                cond_.wait( lock, [this]{ return stop_ || !tasks_.empty(); } );
+                if( tasks_.empty() )
+                    return;
+                job = std::move( tasks_.front() );
+                tasks_.pop();
+            }
+            job();
+        }
+    }
+};
+
+// Runs a byte transform (to_lower, to_upper, table_transform...) over data that does not fit
+// in one string. Files are mmapped and cut in chunks shared by the threads, each one writing
+// straight to the mapped output, with non-temporal stores when the output is larger than the
+// last level cache. Pipes are read in fixed size chunks that are transformed in place by the
+// pool and written back in order. Chunks are independent, so Transform_T must work byte by
+// byte (utf8_to_lower does not).
+template< typename Transform_T >
+class stream_transform
+{
+public:
+    stream_transform( size_t threads = std::thread::hardware_concurrency(),
+                      size_t chunk_size = 0x00400000,
+                      const Transform_T& transform = Transform_T() )
+        : threads_( std::max< size_t >( 1, threads ) ),
+          chunk_size_( std::max< size_t >( 0x1000, chunk_size ) ),
+          transform_( transform ){}
+
+    void operator()( const std::string& input, const std::string& output ) const
+    {
+        int in = open( input.c_str(), O_RDONLY );
+        if( in < 0 )
+            throw std::system_error( errno, std::generic_category(), "open " + input );
+
+        struct stat st;
+        if( fstat( in, &st ) < 0 )
+        {
+            close( in );
+            throw std::system_error( errno, std::generic_category(), "stat " + input );
+        }
+
+        int out = open( output.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644 );
+        if( out < 0 )
+        {
+            close( in );
+            throw std::system_error( errno, std::generic_category(), "open " + output );
+        }
+
+        size_t size = st.st_size;
+        try
+        {
+            if( size > 0 )
+                map( in, out, size );
+        }
+        catch( ... )
+        {
+            close( in );
+            close( out );
+            throw;
+        }
+        close( in );
+        close( out );
+    }
+
+    void operator()( int in_fd, int out_fd ) const
+    {
+        struct chunk
+        {
+            aligned_string data;
+            size_t size;
+            std::future< void > done;
+        };
+
+        // The buffers are declared before the pool, so on an exception the pool runs and joins the
+        // queued tasks while the chunks they write to are still alive
+        std::deque< chunk > inflight;
+        std::vector< aligned_string > free;
+        worker_pool pool( threads_ );
+
+        while( true )
+        {
+            if( inflight.size() == 2 * threads_ )
+            {
+                free.push_back( write_front( inflight, out_fd ) );
+            }
+
+            chunk next;
+            if( !free.empty() )
+            {
+                next.data.swap( free.back() );
+                free.pop_back();
+            }
+            next.data.resize( chunk_size_ );
+            next.size = read_chunk( in_fd, (char*) next.data.data(), chunk_size_ );
+            if( next.size == 0 )
+                break;
+
+            char* ptr = (char*) next.data.data();
+            size_t size = next.size;
+            next.done = pool.submit( [this, ptr, size]{ transform_.run( ptr, ptr, size ); } );
+            inflight.push_back( std::move( next ) );
+        }
+
+        while( !inflight.empty() )
+        {
+            write_front( inflight, out_fd );
+        }
+    }
+
+private:
+    size_t threads_;
+    size_t chunk_size_;
+    Transform_T transform_;
+
+    static size_t cache_size()
+    {
+        long llc = sysconf( _SC_LEVEL3_CACHE_SIZE );
+        return (llc > 0) ? llc : 0x02000000;
+    }
+
+    void map( int in, int out, size_t size ) const
+    {
+        if( ftruncate( out, size ) < 0 )
+            throw std::system_error( errno, std::generic_category(), "ftruncate" );
+
+        void* src = mmap( nullptr, size, PROT_READ, MAP_PRIVATE, in, 0 );
+        if( src == MAP_FAILED )
+            throw std::system_error( errno, std::generic_category(), "mmap" );
+
+        void* dst = mmap( nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, out, 0 );
+        if( dst == MAP_FAILED )
+        {
+            munmap( src, size );
+            throw std::system_error( errno, std::generic_category(), "mmap" );
+        }
+        madvise( src, size, MADV_SEQUENTIAL );
+
+        bool non_temporal = size > cache_size();
+        size_t chunks = (size + chunk_size_ - 1) / chunk_size_;
+        std::atomic< size_t > next( 0 );
+        auto work = [&]
+        {
+            for( size_t i = next++; i < chunks; i = next++ )
+            {
+                size_t off = i * chunk_size_;
+                transform_.run( static_cast< const char* >( src ) + off,
+                                static_cast< char* >( dst ) + off,
+                                std::min( chunk_size_, size - off ), non_temporal );
+            }
+        };
+
+        std::vector< std::thread > workers;
+        for( size_t i = 1; i < std::min( threads_, chunks ); ++i )
+        {
+            workers.emplace_back( work );
+        }
+        work();
+        for( auto&& worker : workers )
+        {
+            worker.join();
+        }
+
+        munmap( src, size );
+        munmap( dst, size );
+    }
+
+    // Reads until the chunk is full or the input ends
+    static size_t read_chunk( int fd, char* ptr, size_t size )
+    {
+        size_t done = 0;
+        while( done < size )
+        {
+            ssize_t ret = read( fd, ptr + done, size - done );
+            if( ret < 0 && errno == EINTR )
+                continue;
+            if( ret < 0 )
+                throw std::system_error( errno, std::generic_category(), "read" );
+            if( ret == 0 )
+                break;
+            done += ret;
+        }
+        return done;
+    }
+
+    template< typename Chunk_T >
+    static aligned_string write_front( std::deque< Chunk_T >& inflight, int fd )
+    {
+        Chunk_T front = std::move( inflight.front() );
+        inflight.pop_front();
+        front.done.get();
+
+        const char* ptr = front.data.data();
+        size_t done = 0;
+        while( done < front.size )
+        {
+            ssize_t ret = write( fd, ptr + done, front.size - done );
+            if( ret < 0 && errno == EINTR )
+                continue;
+            if( ret < 0 )
+                throw std::system_error( errno, std::generic_category(), "write" );
+            done += ret;
+        }
+        return std::move( front.data );
+    }
+};
+
+}} // namespace simd_algorithms::string_algo
+
+#endif // SIMD_ALGORITHMS_STREAM_TRANSFORM_H
@@ -0,0 +1,184 @@
+// MIT License
+//
+// Copyright (c) 2018 André Tupinambá
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "string_search.h"
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <numeric>
+#include <iterator>
+#include <boost/timer/timer.hpp>
+
+bool g_verbose = true;
+namespace sa = simd_algorithms;
+
+void do_nothing( const sa::aligned_string& );
+void do_nothing( size_t );
+
+const std::vector< std::string > g_keywords = { "FATAL", "panic", "OutOfMemory", "Timeout" };
+
+struct std_search
+{
+    size_t count( const sa::aligned_string& text, const std::string& needle )
+    {
+        size_t ret = 0;
+        for( size_t pos = text.find( needle.c_str(), 0, needle.size() ); pos != sa::aligned_string::npos;
+             pos = text.find( needle.c_str(), pos + 1, needle.size() ) )
+        {
+            ++ret;
+        }
+        return ret;
+    }
+
+    size_t count_any( const sa::aligned_string& text )
+    {
+        size_t ret = 0;
+        for( auto&& keyword : g_keywords )
+        {
+            ret += count( text, keyword );
+        }
+        return ret;
+    }
+};
+
+template< typename TAG_T >
+struct simd_search
+{
+    struct counter
+    {
+        size_t count = 0;
+        counter& operator*(){ return *this; }
+        counter& operator++( int ){ return *this; }
+        template< typename T > counter& operator=( const T& ){ ++count; return *this; }
+    };
+
+    size_t count( const sa::aligned_string& text, const std::string& needle )
+    {
+        return sa::string_algo::find_all< TAG_T >( text, needle, counter() ).count;
+    }
+
+    size_t count_any( const sa::aligned_string& text )
+    {
+        return multi_.find_all( text, counter() ).count;
+    }
+
+    sa::string_algo::multi_searcher< TAG_T > multi_{ g_keywords };
+};
+
+// Log like lines: timestamp, level and a message of random words
+sa::aligned_string make_log( size_t size )
+{
+    static const char* levels[] = { "INFO", "DEBUG", "WARN", "ERROR" };
+    static const char* words[] = { "connection", "request", "user", "session", "cache", "miss",
+                                   "retry", "Timeout", "server", "client", "refused", "ok" };
+    sa::aligned_string ret;
+    srand(1);
+    while( ret.size() < size )
+    {
+        ret += "2018-06-01 12:00:";
+        ret += std::to_string( 10 + rand() % 50 ).c_str();
+        ret += ( rand() % 1000 == 0 ) ? " FATAL " : " ";
+        ret += levels[ rand() % 4 ];
+        for( int w = 0; w < 8; ++w )
+        {
+            ret += " ";
+            ret += words[ rand() % 12 ];
+        }
+        ret += "\n";
+    }
+    ret.resize( size );
+    return ret;
+}
+
+template< typename SEARCH_T >
+uint64_t bench( const std::string& name, const sa::aligned_string& text, size_t loop, bool any )
+{
+    boost::timer::cpu_timer timer;
+    SEARCH_T search;
+
+    timer.start();
+    for( size_t j = 0; j < loop; ++j )
+    {
+        do_nothing( any ? search.count_any( text ) : search.count( text, "session refused" ) );
+    }
+    timer.stop();
+    if( g_verbose )
+        std::cout << "Search " << name << ": " << timer.format();
+
+    return timer.elapsed().wall;
+}
+
+int main(int argc, char* /*argv*/[])
+{
+    constexpr size_t runSize = 0x00100001;
+    constexpr size_t loop = 1000;
+    if( argc > 1 )
+    {
+        g_verbose = false;
+        std::cout << "count,base,sse,avx" << std::endl;
+    }
+    else
+    {
+        std::cout << "\nsize: 0x" << std::hex << std::setw(8) << std::setfill( '0') << runSize << std::endl << std::endl;
+    }
+
+    sa::aligned_string text = make_log( runSize );
+    size_t cnt = 0;
+    while( 1 )
+    {
+        uint64_t base = bench< std_search >( "STD ........", text, loop, false );
+        uint64_t sse = bench< simd_search< sa::sse_tag > >( "SSE ........", text, loop, false );
+        uint64_t avx = bench< simd_search< sa::avx_tag > >( "AVX ........", text, loop, false );
+
+        if( g_verbose )
+        {
+            uint64_t base_any = bench< std_search >( "STD any ....", text, loop, true );
+            bench< simd_search< sa::sse_tag > >( "SSE any ....", text, loop, true );
+            uint64_t avx_any = bench< simd_search< sa::avx_tag > >( "AVX any ....", text, loop, true );
+            std::cout
+                      << std::endl << "Speed up SSE.......: " << std::fixed << std::setprecision(2)
+                      << static_cast<float>(base)/static_cast<float>(sse) << "x"
+
+                      << std::endl << "Speed up AVX.......: " << std::fixed << std::setprecision(2)
+                      << static_cast<float>(base)/static_cast<float>(avx) << "x"
+
+                      << std::endl << "Speed up AVX any...: " << std::fixed << std::setprecision(2)
+                      << static_cast<float>(base_any)/static_cast<float>(avx_any) << "x"
+
+                      << std::endl << "AVX GB/s...........: " << std::fixed << std::setprecision(2)
+                      << static_cast<float>(runSize * loop)/static_cast<float>(avx)
+
+                      << std::endl << std::endl;
+        }
+        else
+        {
+            std::cout
+                << ++cnt << ","
+                << base << ","
+                << sse << ","
+                << avx
+                << std::endl;
+        }
+    }
+    return 0;
+}
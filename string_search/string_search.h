@@ -0,0 +1,266 @@
+// MIT License
+//
+// Copyright (c) 2018 André Tupinambá
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef SIMD_ALGORITHMS_STRING_SEARCH_H
+#define SIMD_ALGORITHMS_STRING_SEARCH_H
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include <boost/utility/string_view.hpp>
+#include "../simd_compare.h"
+
+namespace simd_algorithms{
+namespace string_algo{
+
+// Substring search with a first and last byte filter. Each register compares array_size
+// positions against the needle first byte and, needle size - 1 bytes further, against its
+// last byte. Only positions where both match are checked with memcmp.
+// The needle is not copied and must outlive the searcher.
+template< typename TAG_T >
+class searcher
+{
+public:
+    constexpr static size_t array_size = traits< char, TAG_T >::simd_size;
+    constexpr static size_t npos = static_cast< size_t >( -1 );
+
+    searcher( boost::string_view needle )
+        : needle_( needle ){}
+
+    // Positions in [pos, pos + array_size) where needle may start, all must be valid starts
+    static uint32_t candidates( const char* pos, boost::string_view needle )
+    {
+        return result_to_mask< char, TAG_T >(
+            mask_and< TAG_T >( equal< char, TAG_T >( loadu< char, TAG_T >( pos ), needle.front() ),
+                               equal< char, TAG_T >( loadu< char, TAG_T >( pos + needle.size() - 1 ),
+                                                     needle.back() ) ) );
+    }
+
+    static bool match( const char* pos, boost::string_view needle )
+    {
+        return pos[ 0 ] == needle.front()
+            && pos[ needle.size() - 1 ] == needle.back()
+            && std::memcmp( pos, needle.data(), needle.size() ) == 0;
+    }
+
+    // First match at or after pos, npos if none
+    size_t find( boost::string_view haystack, size_t pos = 0 ) const
+    {
+        if( needle_.empty() )
+            return (pos <= haystack.size()) ? pos : npos;
+        if( needle_.size() > haystack.size() )
+            return npos;
+
+        const char* data = haystack.data();
+        size_t end = haystack.size() - needle_.size() + 1;
+        size_t i = pos;
+        for( ; i + array_size <= end; i += array_size )
+        {
+            uint32_t mask = candidates( data + i, needle_ );
+            while( mask != 0 )
+            {
+                size_t cur = i + _bit_scan_forward( mask );
+                if( std::memcmp( data + cur + 1, needle_.data() + 1, needle_.size() - 1 ) == 0 )
+                    return cur;
+                mask &= mask - 1;
+            }
+        }
+
+        for( ; i < end; ++i )
+        {
+            if( match( data + i, needle_ ) )
+                return i;
+        }
+        return npos;
+    }
+
+    // Every match start, overlapping ones included, written to out
+    template< typename OutputIt_T >
+    OutputIt_T find_all( boost::string_view haystack, OutputIt_T out ) const
+    {
+        if( needle_.empty() || needle_.size() > haystack.size() )
+            return out;
+
+        const char* data = haystack.data();
+        size_t end = haystack.size() - needle_.size() + 1;
+        size_t i = 0;
+        for( ; i + array_size <= end; i += array_size )
+        {
+            uint32_t mask = candidates( data + i, needle_ );
+            while( mask != 0 )
+            {
+                size_t cur = i + _bit_scan_forward( mask );
+                if( std::memcmp( data + cur + 1, needle_.data() + 1, needle_.size() - 1 ) == 0 )
+                    *out++ = cur;
+                mask &= mask - 1;
+            }
+        }
+
+        for( ; i < end; ++i )
+        {
+            if( match( data + i, needle_ ) )
+                *out++ = i;
+        }
+        return out;
+    }
+
+private:
+    boost::string_view needle_;
+};
+
+template< typename TAG_T >
+inline size_t find( boost::string_view haystack, boost::string_view needle, size_t pos = 0 )
+{
+    return searcher< TAG_T >( needle ).find( haystack, pos );
+}
+
+template< typename TAG_T, typename OutputIt_T >
+inline OutputIt_T find_all( boost::string_view haystack, boost::string_view needle, OutputIt_T out )
+{
+    return searcher< TAG_T >( needle ).find_all( haystack, out );
+}
+
+// Search for a small set of keywords in one pass. The candidate masks of every keyword are
+// or-ed per register and the set bits are checked in position order, so the first match in
+// the haystack is found first. Ties go to the keyword that comes first in the set.
+template< typename TAG_T >
+class multi_searcher
+{
+public:
+    using simd_type = typename traits< char, TAG_T >::simd_type;
+    constexpr static size_t array_size = traits< char, TAG_T >::simd_size;
+    constexpr static size_t npos = static_cast< size_t >( -1 );
+
+    // Position and keyword index of a match
+    using result_type = std::pair< size_t, size_t >;
+
+    multi_searcher( const std::vector< std::string >& keywords )
+        : keywords_( keywords )
+    {
+        for( auto&& keyword : keywords_ )
+        {
+            if( keyword.empty() )
+                throw std::invalid_argument( "multi_searcher: empty keyword" );
+            longest_ = std::max( longest_, keyword.size() );
+            edges_.push_back( edge{ keyword.front(), keyword.back(), keyword.size() - 1 } );
+        }
+    }
+
+    // First match at or after pos, { npos, npos } if none
+    result_type find( boost::string_view haystack, size_t pos = 0 ) const
+    {
+        result_type ret( static_cast< size_t >( npos ), static_cast< size_t >( npos ) );
+        scan( haystack, pos, [&]( size_t cur, size_t k ){ ret = result_type( cur, k ); return true; } );
+        return ret;
+    }
+
+    // Every match of every keyword, by position then keyword index
+    template< typename OutputIt_T >
+    OutputIt_T find_all( boost::string_view haystack, OutputIt_T out ) const
+    {
+        scan( haystack, 0, [&]( size_t cur, size_t k ){ *out++ = result_type( cur, k ); return false; } );
+        return out;
+    }
+
+private:
+    // Keywords past this one are checked at every candidate position
+    constexpr static size_t max_keywords = 16;
+
+    // First and last bytes of a keyword
+    struct edge
+    {
+        char first;
+        char last;
+        size_t last_offset;
+    };
+
+    std::vector< std::string > keywords_;
+    std::vector< edge > edges_;
+    size_t longest_ = 1;
+
+    // Calls found( pos, keyword ) for each match in order until it returns true
+    template< typename Found_T >
+    void scan( boost::string_view haystack, size_t pos, Found_T found ) const
+    {
+        const char* data = haystack.data();
+        size_t count = keywords_.size();
+        size_t i = pos;
+
+        // Every keyword fits after each position of the register
+        if( haystack.size() >= longest_ )
+        {
+            size_t end = haystack.size() - longest_ + 1;
+            uint32_t masks[ max_keywords ];
+            for( ; i + array_size <= end; i += array_size )
+            {
+                // The first byte register is shared by every keyword
+                simd_type block = loadu< char, TAG_T >( data + i );
+                uint32_t any = 0;
+                for( size_t k = 0; k < count; ++k )
+                {
+                    const edge& cur = edges_[k];
+                    uint32_t mask = result_to_mask< char, TAG_T >(
+                        mask_and< TAG_T >( equal< char, TAG_T >( block, cur.first ),
+                                           equal< char, TAG_T >( loadu< char, TAG_T >( data + i + cur.last_offset ),
+                                                                 cur.last ) ) );
+                    if( k < max_keywords )
+                        masks[k] = mask;
+                    any |= mask;
+                }
+
+                while( any != 0 )
+                {
+                    uint32_t bit = any & (0 - any);
+                    size_t cur = i + _bit_scan_forward( any );
+                    for( size_t k = 0; k < count; ++k )
+                    {
+                        bool hit = (k < max_keywords)
+                            ? (masks[k] & bit) != 0
+                              && std::memcmp( data + cur + 1, keywords_[k].data() + 1, edges_[k].last_offset ) == 0
+                            : searcher< TAG_T >::match( data + cur, keywords_[k] );
+                        if( hit && found( cur, k ) )
+                            return;
+                    }
+                    any &= any - 1;
+                }
+            }
+        }
+
+        for( ; i < haystack.size(); ++i )
+        {
+            for( size_t k = 0; k < count; ++k )
+            {
+                if( i + keywords_[k].size() <= haystack.size()
+                    && searcher< TAG_T >::match( data + i, keywords_[k] )
+                    && found( i, k ) )
+                    return;
+            }
+        }
+    }
+};
+
+}} // namespace simd_algorithms::string_algo
+
+#endif // SIMD_ALGORITHMS_STRING_SEARCH_H
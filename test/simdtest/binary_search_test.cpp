@@ -0,0 +1,54 @@
+// MIT License
+//
+// Copyright (c) 2018 André Tupinambá
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "../../binary_search/binary_search.h"
+#include "gtest/gtest.h"
+#include "neighbours_test.h"
+
+namespace {
+
+namespace sa = simd_algorithms;
+
+using container_type = neighbours_test::container_type;
+
+template< typename TAG_T >
+void check_index_cache()
+{
+    srand( 5 );
+    for( size_t size : { 17, 100, 1000, 9999 } )
+    {
+        container_type sorted = neighbours_test::sorted_sample( size );
+        neighbours_test::check_neighbours< sa::binary_search::index_cache< container_type, TAG_T > >( sorted );
+    }
+}
+
+} // namespace
+
+TEST(BinarySearchTest, SSE)
+{
+    check_index_cache< sa::sse_tag >();
+}
+
+TEST(BinarySearchTest, AVX)
+{
+    check_index_cache< sa::avx_tag >();
+}
@@ -0,0 +1,110 @@
+// MIT License
+//
+// Copyright (c) 2018 André Tupinambá
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "../../bloom_filter/bloom_filter.h"
+#include "../../nway_tree/nway_tree.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+namespace {
+
+namespace sa = simd_algorithms;
+
+template< typename TAG_T >
+void check_bloom_filter( double max_false_positive )
+{
+    srand( 1 );
+    std::unordered_set< int32_t > keys;
+    while( keys.size() < 20000 )
+    {
+        keys.insert( rand() );
+    }
+
+    sa::bloom_filter< int32_t, TAG_T > filter( keys.size() );
+    for( auto key : keys )
+    {
+        filter.insert( key );
+    }
+    for( auto key : keys )
+    {
+        ASSERT_TRUE( filter.may_contain( key ) ) << "key: " << key;
+    }
+
+    size_t tested = 0;
+    size_t positive = 0;
+    for( int32_t key = -1; tested < 200000; --key )
+    {
+        ++tested;
+        positive += filter.may_contain( key );
+    }
+    double rate = static_cast< double >( positive ) / tested;
+    EXPECT_LT( rate, max_false_positive );
+
+    filter.clear();
+    EXPECT_FALSE( filter.may_contain( *keys.begin() ) );
+}
+
+template< typename TAG_T >
+void check_filtered_index()
+{
+    using container_type = sa::aligned_vector< int32_t >;
+    using index_type = sa::nway_tree::index< container_type, TAG_T >;
+
+    srand( 2 );
+    container_type sorted;
+    for( size_t i = 0; i < 10000; ++i )
+    {
+        sorted.push_back( rand() % 100000 );
+    }
+    std::sort( sorted.begin(), sorted.end() );
+    sorted.erase( std::unique( sorted.begin(), sorted.end() ), sorted.end() );
+
+    index_type index( sorted );
+    index.build_index();
+    sa::filtered_index< index_type, TAG_T > filtered( sorted );
+    filtered.build_index();
+
+    // Keys past the last value are misses too
+    for( int32_t key = -10; key < 100010; ++key )
+    {
+        auto expected = std::lower_bound( sorted.begin(), sorted.end(), key );
+        expected = (expected != sorted.end() && *expected == key) ? expected : sorted.end();
+        ASSERT_EQ( expected, index.find( key ) ) << "key: " << key;
+        ASSERT_EQ( expected, filtered.find( key ) ) << "key: " << key;
+    }
+}
+
+} // namespace
+
+TEST(BloomFilterTest, SSE)
+{
+    check_bloom_filter< sa::sse_tag >( 0.01 );
+    check_filtered_index< sa::sse_tag >();
+}
+
+TEST(BloomFilterTest, AVX)
+{
+    check_bloom_filter< sa::avx_tag >( 0.005 );
+    check_filtered_index< sa::avx_tag >();
+}
@@ -0,0 +1,68 @@
+// MIT License
+//
+// Copyright (c) 2018 André Tupinambá
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "../../bubble_sort/bubble_sort.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+
+namespace {
+
+template< typename TAG_T >
+void check_nearly_sorted()
+{
+    namespace sa = simd_algorithms;
+    using container = sa::aligned_vector< int32_t >;
+
+    for( size_t size : { 1, 2, 9, 1000, 100003 } )
+    {
+        for( size_t stragglers : { size_t(0), size_t(1), size / 100 + 1, size } )
+        {
+            container org;
+            srand( 1 );
+            std::generate_n( std::back_inserter( org ), size, []{ return rand() % 10000; } );
+            std::sort( org.begin(), org.end() );
+            for( size_t i = 0; i < stragglers; ++i )
+            {
+                org[ rand() % size ] = rand() % 10000;
+            }
+
+            container sorted( org );
+            std::sort( sorted.begin(), sorted.end() );
+
+            sa::sort::nearly_sorted< container, TAG_T >().sort( org );
+            EXPECT_EQ( sorted, org ) << "size: " << size << ", stragglers: " << stragglers;
+        }
+    }
+}
+
+} // namespace
+
+TEST(BubbleSortTest, NearlySortedSSE)
+{
+    check_nearly_sorted< simd_algorithms::sse_tag >();
+}
+
+TEST(BubbleSortTest, NearlySortedAVX)
+{
+    check_nearly_sorted< simd_algorithms::avx_tag >();
+}
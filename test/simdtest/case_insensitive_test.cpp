@@ -0,0 +1,119 @@
+// MIT License
+//
+// Copyright (c) 2018 André Tupinambá
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "../../case_insensitive/case_insensitive.h"
+#include "gtest/gtest.h"
+
+#include <strings.h>
+#include <unordered_set>
+
+namespace {
+
+std::string scalar_lower( std::string str )
+{
+    for( auto&& ch : str )
+    {
+        ch = ('A' <= ch && ch <= 'Z') ? ch + 0x20 : ch;
+    }
+    return str;
+}
+
+int sign( int val )
+{
+    return (val > 0) - (val < 0);
+}
+
+template< typename TAG_T >
+void check_case_insensitive()
+{
+    namespace sa = simd_algorithms;
+    using boost::string_view;
+
+    std::string text = "GET /Index.HTML HTTP/1.1\r\nHost: example.com\r\nContent-Length: 42\r\n"
+                       "X-\xc3\x89T\xc3\xa9: \x80\xff\r\n\r\n";
+    std::string upper( text );
+    for( auto&& ch : upper )
+    {
+        ch = ('a' <= ch && ch <= 'z') ? ch - 0x20 : ch;
+    }
+
+    for( size_t len = 0; len <= text.size(); ++len )
+    {
+        string_view lhs( text.data(), len );
+        string_view rhs( upper.data(), len );
+        EXPECT_TRUE( sa::string_algo::iequals< TAG_T >( lhs, rhs ) ) << "len: " << len;
+        EXPECT_EQ( 0, sa::string_algo::icompare< TAG_T >( lhs, rhs ) ) << "len: " << len;
+        EXPECT_EQ( sa::string_algo::ihash< TAG_T >()( lhs ), sa::string_algo::ihash< TAG_T >()( rhs ) );
+        EXPECT_EQ( sa::string_algo::ihash< TAG_T >()( lhs ), sa::string_algo::ihash< sa::sse_tag >()( lhs ) );
+
+        if( len > 0 )
+        {
+            // One byte changed at every position, including the overlapped last register
+            for( size_t pos = 0; pos < len; ++pos )
+            {
+                std::string other( upper, 0, len );
+                other[pos] = '\x7f';
+                EXPECT_FALSE( sa::string_algo::iequals< TAG_T >( lhs, other ) );
+                EXPECT_EQ( sign( strncmp( scalar_lower( std::string( lhs ) ).c_str(),
+                                          scalar_lower( other ).c_str(), len ) ),
+                           sign( sa::string_algo::icompare< TAG_T >( lhs, other ) ) )
+                    << "len: " << len << " pos: " << pos;
+            }
+            EXPECT_LT( sa::string_algo::icompare< TAG_T >( lhs.substr( 0, len - 1 ), rhs ), 0 );
+            EXPECT_GT( sa::string_algo::icompare< TAG_T >( lhs, rhs.substr( 0, len - 1 ) ), 0 );
+            EXPECT_FALSE( sa::string_algo::iequals< TAG_T >( lhs.substr( 0, len - 1 ), rhs ) );
+        }
+    }
+
+    std::string lower = scalar_lower( text );
+    for( size_t pos = 0; pos < text.size(); ++pos )
+    {
+        for( size_t len : { 1, 2, 3, 14, 33 } )
+        {
+            if( pos + len > text.size() )
+                continue;
+            EXPECT_EQ( lower.find( lower.substr( pos, len ) ),
+                       sa::string_algo::ifind< TAG_T >( upper, string_view( text ).substr( pos, len ) ) )
+                << "pos: " << pos << " len: " << len;
+        }
+    }
+    EXPECT_EQ( 0, sa::string_algo::ifind< TAG_T >( text, "" ) );
+    EXPECT_EQ( size_t( string_view::npos ), sa::string_algo::ifind< TAG_T >( text, "content-type" ) );
+    EXPECT_EQ( size_t( string_view::npos ), sa::string_algo::ifind< TAG_T >( "host", "hosts" ) );
+
+    std::unordered_set< string_view, sa::string_algo::ihash< TAG_T >, sa::string_algo::iequal_to< TAG_T > >
+        headers{ "Host", "Content-Length" };
+    EXPECT_EQ( 1, headers.count( "CONTENT-LENGTH" ) );
+    EXPECT_EQ( 0, headers.count( "Content-Type" ) );
+}
+
+} // namespace
+
+TEST(CaseInsensitiveTest, SSE)
+{
+    check_case_insensitive< simd_algorithms::sse_tag >();
+}
+
+TEST(CaseInsensitiveTest, AVX)
+{
+    check_case_insensitive< simd_algorithms::avx_tag >();
+}
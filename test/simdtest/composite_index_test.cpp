@@ -0,0 +1,105 @@
+// MIT License
+//
+// Copyright (c) 2018 André Tupinambá
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "../../nway_tree/composite_index.h"
+#include "../../binary_search/composite_index.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+namespace {
+
+namespace sa = simd_algorithms;
+
+using container_type = sa::aligned_vector< int32_t >;
+
+template< class Index_T >
+void check_composite( size_t count )
+{
+    // Few tenants with many timestamps each, the extremes included
+    srand( 7 );
+    std::vector< std::pair< int32_t, int32_t > > rows;
+    for( size_t i = 0; i < count; ++i )
+    {
+        rows.emplace_back( rand() % 20 - 10, rand() % 1000 );
+    }
+    if( count > 2 )
+    {
+        rows.back() = std::make_pair( std::numeric_limits< int32_t >::max(), std::numeric_limits< int32_t >::max() );
+        rows.front() = std::make_pair( std::numeric_limits< int32_t >::min(), 0 );
+    }
+    std::sort( rows.begin(), rows.end() );
+
+    container_type major;
+    container_type minor;
+    for( auto& row : rows )
+    {
+        major.push_back( row.first );
+        minor.push_back( row.second );
+    }
+
+    Index_T index( major, minor );
+    index.build_index();
+    ASSERT_EQ( rows.size(), index.size() );
+
+    for( int32_t tenant = -12; tenant < 12; ++tenant )
+    {
+        for( int32_t stamp = -2; stamp < 1002; ++stamp )
+        {
+            auto key = std::make_pair( tenant, stamp );
+            auto first = std::lower_bound( rows.begin(), rows.end(), key );
+            size_t pos = first - rows.begin();
+            ASSERT_EQ( pos, index.lower_bound( tenant, stamp ) ) << tenant << "," << stamp;
+            ASSERT_EQ( (first != rows.end() && *first == key) ? pos : rows.size(), index.find( tenant, stamp ) )
+                << tenant << "," << stamp;
+        }
+    }
+    for( auto& row : rows )
+    {
+        size_t pos = std::lower_bound( rows.begin(), rows.end(), row ) - rows.begin();
+        ASSERT_EQ( pos, index.find( row.first, row.second ) );
+    }
+}
+
+template< typename TAG_T >
+void check_composite_indexes()
+{
+    for( size_t count : { 0, 1, 3, 9, 100, 5000 } )
+    {
+        check_composite< sa::nway_tree::composite_index< container_type, TAG_T > >( count );
+        check_composite< sa::binary_search::composite_index_cache< container_type, TAG_T > >( count );
+    }
+}
+
+} // namespace
+
+TEST(CompositeIndexTest, SSE)
+{
+    check_composite_indexes< sa::sse_tag >();
+}
+
+TEST(CompositeIndexTest, AVX)
+{
+    check_composite_indexes< sa::avx_tag >();
+}
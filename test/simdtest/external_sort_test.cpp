@@ -0,0 +1,115 @@
+// MIT License
+//
+// Copyright (c) 2018 André Tupinambá
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "../../external_sort/external_sort.h"
+#include "gtest/gtest.h"
+
+#include <dirent.h>
+#include <sys/stat.h>
+#include <algorithm>
+#include <cstdio>
+
+namespace {
+
+template< class Cont_T, typename TAG_T >
+struct stl_sort
+{
+	using container_type = Cont_T;
+
+    void sort( container_type& cont )
+    {
+        std::sort( std::begin( cont ), std::end( cont ) );
+    }
+};
+
+} // namespace
+
+TEST(ExternalSortTest, MultiPass)
+{
+    namespace sa = simd_algorithms;
+    using container = sa::sort::page_aligned_vector< int32_t >;
+
+    // 3M keys with 2MB of memory: six runs and two merge passes
+    constexpr size_t size = 3000001;
+    container org;
+    srand( 1 );
+    std::generate_n( std::back_inserter( org ), size, &rand );
+
+    std::string input = testing::TempDir() + "external_sort_in.bin";
+    std::string output = testing::TempDir() + "external_sort_out.bin";
+    FILE* in = fopen( input.c_str(), "wb" );
+    ASSERT_NE( nullptr, in );
+    fwrite( org.data(), sizeof(int32_t), org.size(), in );
+    fclose( in );
+
+    sa::sort::external< int32_t, sa::sse_tag, stl_sort > sorter( 0x00200000, testing::TempDir(), true );
+    sorter.sort( input, output );
+
+    container keys( size + 1 );
+    FILE* out = fopen( output.c_str(), "rb" );
+    ASSERT_NE( nullptr, out );
+    EXPECT_EQ( size, fread( keys.data(), sizeof(int32_t), keys.size(), out ) );
+    fclose( out );
+    keys.resize( size );
+
+    std::sort( org.begin(), org.end() );
+    EXPECT_EQ( org, keys );
+
+    remove( input.c_str() );
+    remove( output.c_str() );
+}
+
+TEST(ExternalSortTest, FailedSortRemovesRuns)
+{
+    namespace sa = simd_algorithms;
+
+    // 1M keys with 2MB of memory: two runs, then the final merge cannot open the output
+    std::string temp_dir = testing::TempDir() + "external_sort_runs";
+    mkdir( temp_dir.c_str(), 0755 );
+    std::string input = testing::TempDir() + "external_sort_fail.bin";
+    FILE* in = fopen( input.c_str(), "wb" );
+    ASSERT_NE( nullptr, in );
+    srand( 2 );
+    for( size_t i = 0; i < 1000000; ++i )
+    {
+        int32_t val = rand();
+        fwrite( &val, sizeof(int32_t), 1, in );
+    }
+    fclose( in );
+
+    sa::sort::external< int32_t, sa::sse_tag, stl_sort > sorter( 0x00200000, temp_dir );
+    EXPECT_THROW( sorter.sort( input, temp_dir + "/missing/out.bin" ), std::system_error );
+
+    size_t left = 0;
+    DIR* dir = opendir( temp_dir.c_str() );
+    ASSERT_NE( nullptr, dir );
+    while( dirent* entry = readdir( dir ) )
+    {
+        if( std::string( entry->d_name ) != "." && std::string( entry->d_name ) != ".." )
+            ++left;
+    }
+    closedir( dir );
+    EXPECT_EQ( 0u, left );
+
+    remove( input.c_str() );
+    rmdir( temp_dir.c_str() );
+}
@@ -0,0 +1,103 @@
+// MIT License
+//
+// Copyright (c) 2018 André Tupinambá
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "../../filter/filter.h"
+#include "gtest/gtest.h"
+
+#include <functional>
+#include <limits>
+
+namespace {
+
+namespace sa = simd_algorithms;
+
+template< typename TAG_T, typename Pred_T >
+void check_filter( const sa::aligned_vector< int32_t >& in, const sa::predicate::base< Pred_T >& pred,
+                   std::function< bool( int32_t ) > expect )
+{
+    sa::aligned_vector< int32_t > expected = { 42 };
+    sa::aligned_vector< uint32_t > expected_indices = { 7 };
+    for( size_t i = 0; i < in.size(); ++i )
+    {
+        if( expect( in[i] ) )
+        {
+            expected.push_back( in[i] );
+            expected_indices.push_back( static_cast< uint32_t >( i ) );
+        }
+    }
+
+    // Results are appended
+    sa::aligned_vector< int32_t > found = { 42 };
+    sa::aligned_vector< uint32_t > found_indices = { 7 };
+    EXPECT_EQ( expected.size() - 1, (sa::filter< TAG_T >( in, pred, found )) );
+    EXPECT_EQ( expected, found ) << "size: " << in.size();
+    EXPECT_EQ( expected_indices.size() - 1, (sa::filter_indices< TAG_T >( in, pred, found_indices )) );
+    EXPECT_EQ( expected_indices, found_indices ) << "size: " << in.size();
+}
+
+template< typename TAG_T >
+void check_filter_all()
+{
+    namespace pr = sa::predicate;
+
+    srand( 1 );
+    for( size_t size : { 0, 1, 3, 4, 7, 8, 9, 31, 1000, 1003 } )
+    {
+        sa::aligned_vector< int32_t > in;
+        for( size_t i = 0; i < size; ++i )
+        {
+            in.push_back( rand() % 200 - 100 );
+        }
+        if( size > 2 )
+        {
+            in[0] = std::numeric_limits< int32_t >::min();
+            in[1] = std::numeric_limits< int32_t >::max();
+        }
+
+        check_filter< TAG_T >( in, pr::greater( 10 ), []( int32_t v ){ return v > 10; } );
+        check_filter< TAG_T >( in, pr::less( -3 ), []( int32_t v ){ return v < -3; } );
+        check_filter< TAG_T >( in, pr::equal_to( 5 ), []( int32_t v ){ return v == 5; } );
+        check_filter< TAG_T >( in, pr::between( -20, 20 ), []( int32_t v ){ return -20 <= v && v <= 20; } );
+        check_filter< TAG_T >( in, pr::greater( 1000 ), []( int32_t v ){ return v > 1000; } );
+        check_filter< TAG_T >( in, pr::between( std::numeric_limits< int32_t >::min(),
+                                                std::numeric_limits< int32_t >::max() ),
+                               []( int32_t ){ return true; } );
+        check_filter< TAG_T >( in, pr::greater( 0 ) && !pr::equal_to( 7 ),
+                               []( int32_t v ){ return v > 0 && v != 7; } );
+        check_filter< TAG_T >( in, pr::less( -50 ) || pr::greater( 50 ) || pr::equal_to( 0 ),
+                               []( int32_t v ){ return v < -50 || v > 50 || v == 0; } );
+        check_filter< TAG_T >( in, !(pr::between( -10, 10 ) && !pr::equal_to( 3 )),
+                               []( int32_t v ){ return !(-10 <= v && v <= 10 && v != 3); } );
+    }
+}
+
+} // namespace
+
+TEST(FilterTest, SSE)
+{
+    check_filter_all< sa::sse_tag >();
+}
+
+TEST(FilterTest, AVX)
+{
+    check_filter_all< sa::avx_tag >();
+}
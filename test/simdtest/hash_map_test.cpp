@@ -0,0 +1,151 @@
+// MIT License
+//
+// Copyright (c) 2018 André Tupinambá
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "../../hash_map/hash_map.h"
+#include "gtest/gtest.h"
+
+#include <unordered_map>
+
+namespace {
+
+// Every key in the same group keeps the probes long and the in-place rehash busy
+struct bad_hash
+{
+    size_t operator()( int32_t key ) const
+    {
+        return (key % 4) << 7 | (key & 0x7f);
+    }
+};
+
+template< typename TAG_T, typename Hash_T >
+void check_hash_map_ops()
+{
+    namespace sa = simd_algorithms;
+    using map_type = sa::hash_map< int32_t, int32_t, TAG_T, Hash_T >;
+
+    map_type map;
+    std::unordered_map< int32_t, int32_t > ref;
+    srand( 1 );
+    for( size_t i = 0; i < 20000; ++i )
+    {
+        int32_t key = rand() % 2000;
+        switch( rand() % 4 )
+        {
+        case 0:
+        case 1:
+        {
+            int32_t val = rand();
+            auto ret = map.insert( std::make_pair( key, val ) );
+            auto ref_ret = ref.insert( std::make_pair( key, val ) );
+            EXPECT_EQ( ref_ret.second, ret.second );
+            EXPECT_EQ( ref_ret.first->second, ret.first->second );
+            break;
+        }
+        case 2:
+            EXPECT_EQ( ref.erase( key ), map.erase( key ) );
+            break;
+        default:
+            map[ key ] += 1;
+            ref[ key ] += 1;
+            break;
+        }
+        ASSERT_EQ( ref.size(), map.size() );
+    }
+
+    for( int32_t key = -10; key < 2010; ++key )
+    {
+        auto it = map.find( key );
+        auto ref_it = ref.find( key );
+        ASSERT_EQ( ref_it == ref.end(), it == map.end() ) << "key: " << key;
+        if( it != map.end() )
+        {
+            EXPECT_EQ( ref_it->second, it->second );
+        }
+    }
+
+    size_t count = 0;
+    for( auto&& item : map )
+    {
+        EXPECT_EQ( ref[ item.first ], item.second );
+        ++count;
+    }
+    EXPECT_EQ( ref.size(), count );
+
+    // Erase everything but one key and fill again, the tombstones are reused or rehashed away
+    size_t capacity = map.capacity();
+    for( int32_t key = 1; key < 2000; ++key )
+    {
+        map.erase( key );
+    }
+    for( int32_t round = 1; round < 20; ++round )
+    {
+        for( int32_t key = round * 1000; key < round * 1000 + 1000; ++key )
+        {
+            map.insert( std::make_pair( key, key ) );
+        }
+        for( int32_t key = round * 1000; key < round * 1000 + 1000; ++key )
+        {
+            map.erase( map.find( key ) );
+        }
+    }
+    EXPECT_EQ( capacity, map.capacity() );
+    EXPECT_EQ( ref.count( 0 ), map.size() );
+}
+
+template< typename TAG_T >
+void check_hash_map()
+{
+    namespace sa = simd_algorithms;
+
+    check_hash_map_ops< TAG_T, sa::mix_hash< int32_t > >();
+    check_hash_map_ops< TAG_T, bad_hash >();
+
+    sa::hash_map< int32_t, size_t, TAG_T > map( 1000 );
+    std::vector< int32_t > keys;
+    for( int32_t i = 0; i < 1000; ++i )
+    {
+        map[ i * 7 ] = i;
+        keys.push_back( i * 3 );
+    }
+    std::vector< typename sa::hash_map< int32_t, size_t, TAG_T >::const_iterator > found;
+    map.find( keys.data(), keys.size(), std::back_inserter( found ) );
+    ASSERT_EQ( keys.size(), found.size() );
+    for( size_t i = 0; i < keys.size(); ++i )
+    {
+        if( keys[i] % 7 == 0 )
+            EXPECT_EQ( keys[i] / 7, found[i]->second );
+        else
+            EXPECT_TRUE( found[i] == map.end() );
+    }
+}
+
+} // namespace
+
+TEST(HashMapTest, SSE)
+{
+    check_hash_map< simd_algorithms::sse_tag >();
+}
+
+TEST(HashMapTest, AVX)
+{
+    check_hash_map< simd_algorithms::avx_tag >();
+}
@@ -0,0 +1,121 @@
+// MIT License
+//
+// Copyright (c) 2018 André Tupinambá
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "../../learned/learned.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace {
+
+namespace sa = simd_algorithms;
+
+using container_type = sa::aligned_vector< int32_t >;
+using timestamps_type = sa::aligned_vector< int64_t >;
+
+template< typename TAG_T, class Cont_T >
+void check_index( const Cont_T& sorted, size_t error )
+{
+    using value_type = typename Cont_T::value_type;
+
+    sa::learned::index< Cont_T, TAG_T > index( sorted, error );
+    index.build_index();
+
+    Cont_T keys( sorted.begin(), sorted.end() );
+    for( auto value : sorted )
+    {
+        keys.push_back( value - 1 );
+        keys.push_back( value + 1 );
+    }
+    keys.push_back( std::numeric_limits< value_type >::min() );
+    keys.push_back( std::numeric_limits< value_type >::max() );
+
+    for( auto key : keys )
+    {
+        auto first = std::lower_bound( sorted.begin(), sorted.end(), key );
+        ASSERT_EQ( first - sorted.begin(), index.lower_bound( key ) - sorted.begin() ) << "key: " << key;
+        auto expected = (first != sorted.end() && *first == key) ? first : sorted.end();
+        ASSERT_EQ( expected - sorted.begin(), index.find( key ) - sorted.begin() ) << "key: " << key;
+    }
+}
+
+template< typename TAG_T >
+void check_learned()
+{
+    container_type sorted;
+    check_index< TAG_T >( sorted, 16 );
+
+    sorted.push_back( 42 );
+    check_index< TAG_T >( sorted, 16 );
+
+    // Sequential keys fit a single segment
+    sorted.clear();
+    for( int32_t i = 0; i < 10000; ++i )
+    {
+        sorted.push_back( i * 10 );
+    }
+    sa::learned::index< container_type, TAG_T > line( sorted );
+    line.build_index();
+    EXPECT_EQ( 1u, line.segment_count() );
+    check_index< TAG_T >( sorted, 16 );
+
+    // Random keys with long runs of duplicates, several error bounds
+    srand( 4 );
+    sorted.clear();
+    for( size_t i = 0; i < 10000; ++i )
+    {
+        sorted.push_back( rand() % 1000000 - 500000 );
+    }
+    sorted.insert( sorted.end(), 500, 1234 );
+    sorted.insert( sorted.end(), 100, -777 );
+    std::sort( sorted.begin(), sorted.end() );
+    for( size_t error : { 0, 1, 4, 16, 64 } )
+    {
+        check_index< TAG_T >( sorted, error );
+    }
+
+    // Millisecond timestamps, one event every 1 to 1000 ms
+    timestamps_type stamps;
+    int64_t now = 1500000000000;
+    for( size_t i = 0; i < 10000; ++i )
+    {
+        now += rand() % 1000 + 1;
+        stamps.push_back( now );
+    }
+    for( size_t error : { 0, 4, 16, 64 } )
+    {
+        check_index< TAG_T >( stamps, error );
+    }
+}
+
+} // namespace
+
+TEST(LearnedTest, SSE)
+{
+    check_learned< sa::sse_tag >();
+}
+
+TEST(LearnedTest, AVX)
+{
+    check_learned< sa::avx_tag >();
+}
@@ -0,0 +1,112 @@
+// MIT License
+//
+// Copyright (c) 2018 André Tupinambá
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "../../merge/merge.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace {
+
+namespace sa = simd_algorithms;
+
+sa::aligned_vector< int32_t > make_sorted( size_t size, int32_t range )
+{
+    sa::aligned_vector< int32_t > ret;
+    for( size_t i = 0; i < size; ++i )
+    {
+        ret.push_back( rand() % range - range / 2 );
+    }
+    std::sort( ret.begin(), ret.end() );
+    return ret;
+}
+
+template< typename TAG_T >
+void check_merge( const sa::aligned_vector< int32_t >& a, const sa::aligned_vector< int32_t >& b, size_t threads )
+{
+    sa::aligned_vector< int32_t > expected;
+    std::merge( a.begin(), a.end(), b.begin(), b.end(), std::back_inserter( expected ) );
+
+    sa::aligned_vector< int32_t > found;
+    sa::merge< TAG_T >( a, b, found, threads );
+    EXPECT_EQ( expected, found ) << "sizes: " << a.size() << " " << b.size() << " threads: " << threads;
+}
+
+template< typename TAG_T >
+void check_merge_all()
+{
+    srand( 1 );
+    for( size_t na : { 0, 1, 7, 8, 9, 100, 1000, 4000 } )
+    {
+        for( size_t nb : { 0, 3, 8, 17, 1000, 5000 } )
+        {
+            // Few distinct values, many ties between the inputs
+            check_merge< TAG_T >( make_sorted( na, 10 ), make_sorted( nb, 10 ), 1 );
+            check_merge< TAG_T >( make_sorted( na, 100000 ), make_sorted( nb, 100000 ), 1 );
+        }
+    }
+
+    sa::aligned_vector< int32_t > ext = { std::numeric_limits< int32_t >::min(), 0, 0,
+                                          std::numeric_limits< int32_t >::max(),
+                                          std::numeric_limits< int32_t >::max() };
+    check_merge< TAG_T >( ext, make_sorted( 3, 10 ), 1 );
+    check_merge< TAG_T >( make_sorted( 3, 10 ), ext, 1 );
+    check_merge< TAG_T >( make_sorted( 1000, 100 ), ext, 1 );
+
+    // Parts split by merge path
+    sa::aligned_vector< int32_t > a = make_sorted( 300000, 1000 );
+    sa::aligned_vector< int32_t > b = make_sorted( 200000, 1000 );
+    for( size_t threads : { 2, 3, 7 } )
+    {
+        check_merge< TAG_T >( a, b, threads );
+        check_merge< TAG_T >( a, make_sorted( 5000, 1000 ), threads );
+    }
+
+    for( size_t diagonal : { 0, 1, 1000, 250000, 499999, 500000 } )
+    {
+        size_t i = sa::merger< TAG_T >::merge_path( a.data(), a.size(), b.data(), b.size(), diagonal );
+        size_t j = diagonal - i;
+        ASSERT_LE( i, a.size() );
+        ASSERT_LE( j, b.size() );
+        if( i > 0 && j < b.size() )
+        {
+            EXPECT_LE( a[ i - 1 ], b[ j ] );
+        }
+        if( j > 0 && i < a.size() )
+        {
+            EXPECT_LT( b[ j - 1 ], a[ i ] );
+        }
+    }
+}
+
+} // namespace
+
+TEST(MergeTest, SSE)
+{
+    check_merge_all< sa::sse_tag >();
+}
+
+TEST(MergeTest, AVX)
+{
+    check_merge_all< sa::avx_tag >();
+}
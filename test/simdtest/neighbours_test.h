@@ -0,0 +1,106 @@
+// MIT License
+//
+// Copyright (c) 2018 André Tupinambá
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef SIMD_ALGORITHMS_NEIGHBOURS_TEST_H
+#define SIMD_ALGORITHMS_NEIGHBOURS_TEST_H
+
+#include "../../simd_compare.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+
+// Shared checks of the successor, predecessor and nearest queries, run against every index that
+// forwards them to neighbours.h
+namespace neighbours_test {
+
+using container_type = simd_algorithms::aligned_vector< int32_t >;
+
+// Random values with duplicates, ending at INT_MAX
+inline container_type sorted_sample( size_t size )
+{
+    container_type sorted;
+    for( size_t i = 0; i < size; ++i )
+    {
+        sorted.push_back( rand() % (size * 8) - static_cast< int32_t >( size * 4 ) );
+    }
+    sorted.push_back( std::numeric_limits< int32_t >::max() );
+    std::sort( sorted.begin(), sorted.end() );
+    return sorted;
+}
+
+template< class Index_T >
+void check_neighbours( const container_type& sorted )
+{
+    Index_T index( sorted );
+    index.build_index();
+
+    container_type keys( sorted.begin(), sorted.end() );
+    for( auto value : sorted )
+    {
+        keys.push_back( value - 1 );
+        if( value < std::numeric_limits< int32_t >::max() )
+        {
+            keys.push_back( value + 1 );
+        }
+    }
+    keys.push_back( std::numeric_limits< int32_t >::min() );
+    keys.push_back( std::numeric_limits< int32_t >::max() );
+
+    for( auto key : keys )
+    {
+        auto succ = std::lower_bound( sorted.begin(), sorted.end(), key );
+        auto upper = std::upper_bound( sorted.begin(), sorted.end(), key );
+        auto pred = (upper == sorted.begin()) ? sorted.end() : std::prev( upper );
+
+        ASSERT_EQ( succ - sorted.begin(), index.successor( key ) - sorted.begin() ) << "key: " << key;
+
+        auto ret = index.predecessor( key );
+        ASSERT_EQ( pred == sorted.end(), ret == sorted.end() ) << "key: " << key;
+        if( pred != sorted.end() )
+        {
+            ASSERT_EQ( *pred, *ret ) << "key: " << key;
+        }
+
+        ret = index.nearest( key );
+        ASSERT_TRUE( ret != sorted.end() ) << "key: " << key;
+        int64_t best = std::numeric_limits< int64_t >::max();
+        if( succ != sorted.end() )
+        {
+            best = static_cast< int64_t >( *succ ) - key;
+        }
+        if( pred != sorted.end() )
+        {
+            best = std::min( best, static_cast< int64_t >( key ) - *pred );
+        }
+        ASSERT_EQ( best, std::abs( static_cast< int64_t >( *ret ) - key ) ) << "key: " << key;
+        if( pred != sorted.end() && static_cast< int64_t >( key ) - *pred == best )
+        {
+            ASSERT_EQ( *pred, *ret ) << "key: " << key;
+        }
+    }
+}
+
+} // namespace neighbours_test
+
+#endif // SIMD_ALGORITHMS_NEIGHBOURS_TEST_H
@@ -0,0 +1,124 @@
+// MIT License
+//
+// Copyright (c) 2018 André Tupinambá
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "../../nway_tree/nway_tree.h"
+#include "gtest/gtest.h"
+#include "neighbours_test.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace {
+
+namespace sa = simd_algorithms;
+
+using container_type = neighbours_test::container_type;
+
+template< typename TAG_T >
+void check_range( const container_type& sorted )
+{
+    sa::nway_tree::index< container_type, TAG_T > index( sorted );
+    index.build_index();
+
+    for( size_t i = 0; i < 2000; ++i )
+    {
+        // The last value is INT_MAX, keep away from it
+        int32_t lo = sorted[ rand() % (sorted.size() - 1) ] + rand() % 3 - 1;
+        int32_t hi = lo + rand() % 200 - 20;
+        auto first = std::lower_bound( sorted.begin(), sorted.end(), lo );
+        auto last = std::max( first, std::lower_bound( sorted.begin(), sorted.end(), hi ) );
+
+        ASSERT_EQ( last - first, index.count( lo, hi ) ) << "lo: " << lo << ", hi: " << hi;
+
+        auto range = index.range( lo, hi );
+        EXPECT_TRUE( range.first == first );
+        EXPECT_TRUE( range.second == last );
+
+        // The blocks are contiguous and cover the range
+        auto next = first;
+        size_t total = index.range( lo, hi, [&]( container_type::const_iterator it, size_t count )
+        {
+            EXPECT_TRUE( it == next );
+            EXPECT_GT( count, 0u );
+            next = std::next( it, count );
+        } );
+        EXPECT_EQ( last - first, total );
+        EXPECT_TRUE( next == last );
+    }
+}
+
+template< typename TAG_T >
+void check_nway_tree()
+{
+    srand( 5 );
+    for( size_t size : { 17, 100, 1000, 9999 } )
+    {
+        container_type sorted = neighbours_test::sorted_sample( size );
+        neighbours_test::check_neighbours< sa::nway_tree::index< container_type, TAG_T > >( sorted );
+        check_range< TAG_T >( sorted );
+    }
+}
+
+// Distances past the int32 range, the int64 lanes are compared with pcmpgtq
+template< typename TAG_T >
+void check_int64_nearest()
+{
+    using int64_container = sa::aligned_vector< int64_t >;
+    const int64_t min = std::numeric_limits< int64_t >::min();
+    const int64_t max = std::numeric_limits< int64_t >::max();
+    int64_container sorted = { min, -(int64_t( 1 ) << 40), -5, 0, int64_t( 1 ) << 40, max - 10, max };
+
+    sa::nway_tree::index< int64_container, TAG_T > index( sorted );
+    index.build_index();
+    EXPECT_EQ( min, *index.nearest( min + 1 ) );
+    EXPECT_EQ( min, *index.nearest( min + (int64_t( 1 ) << 60) ) );
+    EXPECT_EQ( -(int64_t( 1 ) << 40), *index.nearest( -(int64_t( 3 ) << 39) ) );
+    EXPECT_EQ( max - 10, *index.nearest( (int64_t( 1 ) << 62) + (int64_t( 1 ) << 61) ) );
+    EXPECT_EQ( max, *index.nearest( max - 1 ) );
+    EXPECT_EQ( -5, *index.predecessor( -1 ) );
+    EXPECT_EQ( 0, *index.successor( -1 ) );
+
+    // Gaps wider than int64_t itself
+    int64_container extremes = { min, max };
+    sa::nway_tree::index< int64_container, TAG_T > wide( extremes );
+    wide.build_index();
+    EXPECT_EQ( min, *wide.nearest( -1 ) );
+    EXPECT_EQ( max, *wide.nearest( 0 ) );
+}
+
+} // namespace
+
+TEST(NwayTreeTest, Int64Nearest)
+{
+    check_int64_nearest< sa::sse_tag >();
+    check_int64_nearest< sa::avx_tag >();
+}
+
+TEST(NwayTreeTest, SSE)
+{
+    check_nway_tree< sa::sse_tag >();
+}
+
+TEST(NwayTreeTest, AVX)
+{
+    check_nway_tree< sa::avx_tag >();
+}
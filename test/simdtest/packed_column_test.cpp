@@ -0,0 +1,135 @@
+// MIT License
+//
+// Copyright (c) 2018 André Tupinambá
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "../../packed_column/packed_column.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace {
+
+namespace sa = simd_algorithms;
+
+template< typename TAG_T >
+void check_column( const sa::aligned_vector< int32_t >& sorted )
+{
+    using column_type = sa::packed_column< TAG_T >;
+    column_type column( sorted );
+    ASSERT_EQ( sorted.size(), column.size() );
+
+    for( size_t i = 0; i < sorted.size(); ++i )
+    {
+        ASSERT_EQ( sorted[ i ], column[ i ] ) << "pos: " << i;
+    }
+
+    int32_t values[ column_type::block_size ];
+    for( size_t block = 0; block * column_type::block_size < sorted.size(); ++block )
+    {
+        column.decode_block( block, values );
+        size_t count = std::min< size_t >( column_type::block_size, sorted.size() - block * column_type::block_size );
+        EXPECT_TRUE( std::equal( values, values + count, sorted.begin() + block * column_type::block_size ) );
+    }
+
+    // Every value, its neighbours and the extremes
+    sa::aligned_vector< int32_t > keys( sorted.begin(), sorted.end() );
+    for( auto value : sorted )
+    {
+        if( value > std::numeric_limits< int32_t >::min() )
+        {
+            keys.push_back( value - 1 );
+        }
+        if( value < std::numeric_limits< int32_t >::max() )
+        {
+            keys.push_back( value + 1 );
+        }
+    }
+    keys.push_back( std::numeric_limits< int32_t >::min() );
+    keys.push_back( std::numeric_limits< int32_t >::max() );
+
+    for( auto key : keys )
+    {
+        auto first = std::lower_bound( sorted.begin(), sorted.end(), key );
+        size_t pos = first - sorted.begin();
+        ASSERT_EQ( pos, column.lower_bound( key ) ) << "key: " << key;
+        size_t expected = (first != sorted.end() && *first == key) ? pos : static_cast< size_t >( column_type::npos );
+        ASSERT_EQ( expected, column.find( key ) ) << "key: " << key;
+    }
+}
+
+template< typename TAG_T >
+void check_packed_column()
+{
+    sa::aligned_vector< int32_t > sorted;
+    check_column< TAG_T >( sorted );
+
+    sorted.push_back( 7 );
+    check_column< TAG_T >( sorted );
+
+    // Dense, sparse and full range blocks, duplicates and a partial last block
+    srand( 3 );
+    sorted.clear();
+    for( size_t i = 0; i < 5000; ++i )
+    {
+        sorted.push_back( rand() % 2000 );
+    }
+    for( size_t i = 0; i < 5000; ++i )
+    {
+        sorted.push_back( rand() );
+    }
+    for( size_t i = 0; i < 300; ++i )
+    {
+        sorted.push_back( 12345 );
+    }
+    sorted.push_back( std::numeric_limits< int32_t >::min() );
+    sorted.push_back( std::numeric_limits< int32_t >::max() );
+    for( size_t i = 0; i < 100; ++i )
+    {
+        sorted.push_back( -rand() );
+    }
+    std::sort( sorted.begin(), sorted.end() );
+    check_column< TAG_T >( sorted );
+
+    // Every bit width
+    for( int bits = 1; bits < 32; ++bits )
+    {
+        sorted.clear();
+        for( size_t i = 0; i < 300; ++i )
+        {
+            sorted.push_back( static_cast< int32_t >( (static_cast< uint32_t >( rand() ) * 2654435761u) >> (32 - bits) ) );
+        }
+        std::sort( sorted.begin(), sorted.end() );
+        check_column< TAG_T >( sorted );
+    }
+}
+
+} // namespace
+
+TEST(PackedColumnTest, SSE)
+{
+    check_packed_column< sa::sse_tag >();
+}
+
+TEST(PackedColumnTest, AVX)
+{
+    check_packed_column< sa::avx_tag >();
+}
@@ -0,0 +1,98 @@
+// MIT License
+//
+// Copyright (c) 2018 André Tupinambá
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "../../parse_int/parse_int.h"
+#include "gtest/gtest.h"
+
+#include <cstdlib>
+
+namespace {
+
+template< typename Value_T, typename TAG_T >
+void check_parse( const std::string& text )
+{
+    namespace sa = simd_algorithms;
+
+    // Reference: strtoll on every digit run, with the '-' right before it
+    sa::aligned_vector< Value_T > expected;
+    for( size_t pos = 0; pos < text.size(); )
+    {
+        if( text[pos] < '0' || text[pos] > '9' )
+        {
+            ++pos;
+            continue;
+        }
+        size_t start = (pos > 0 && text[pos - 1] == '-') ? pos - 1 : pos;
+        char* end;
+        expected.push_back( static_cast< Value_T >( strtoll( text.c_str() + start, &end, 10 ) ) );
+        pos = end - text.c_str();
+    }
+
+    sa::aligned_vector< Value_T > out( 1, 42 );
+    EXPECT_EQ( expected.size(), ( sa::string_algo::parse_int< Value_T, TAG_T >( text, out ) ) );
+    out.erase( out.begin() );
+    EXPECT_EQ( expected, out );
+}
+
+template< typename TAG_T >
+void check_parse_int()
+{
+    namespace sa = simd_algorithms;
+
+    std::string text = "1 -2 +3 x45x 2147483647 -2147483648 0000000000000000000000000012,7\n"
+                       "abcdefghijklmnopqrstuvwxyz0123456789012345 9999999999999999 -17";
+    std::string text32;
+    srand( 1 );
+    for( size_t i = 0; i < 1000; ++i )
+    {
+        text32 += std::to_string( static_cast< int32_t >( rand() * (i % 3 ? 1 : -1) ) >> (i % 31) );
+        text32 += " ,;\n-x"[ i % 6 ];
+    }
+    std::string text64 = text32 + " 9223372036854775807 -9223372036854775808 1234567890123456789";
+
+    check_parse< int32_t, TAG_T >( text32 );
+    check_parse< int64_t, TAG_T >( text64 );
+    check_parse< int64_t, TAG_T >( text );
+    check_parse< int32_t, TAG_T >( "" );
+    check_parse< int32_t, TAG_T >( "no numbers here at all, none" );
+
+    sa::aligned_vector< int32_t > out32;
+    EXPECT_EQ( 2, ( sa::string_algo::parse_int< int32_t, TAG_T >( "2147483647 -2147483648", out32 ) ) );
+    EXPECT_THROW( ( sa::string_algo::parse_int< int32_t, TAG_T >( "2147483648", out32 ) ), std::out_of_range );
+    EXPECT_THROW( ( sa::string_algo::parse_int< int32_t, TAG_T >( "-2147483649", out32 ) ), std::out_of_range );
+
+    sa::aligned_vector< int64_t > out64;
+    EXPECT_THROW( ( sa::string_algo::parse_int< int64_t, TAG_T >( "9223372036854775808", out64 ) ), std::out_of_range );
+    EXPECT_THROW( ( sa::string_algo::parse_int< int64_t, TAG_T >( "99999999999999999999", out64 ) ), std::out_of_range );
+}
+
+} // namespace
+
+TEST(ParseIntTest, SSE)
+{
+    check_parse_int< simd_algorithms::sse_tag >();
+}
+
+TEST(ParseIntTest, AVX)
+{
+    check_parse_int< simd_algorithms::avx_tag >();
+}
@@ -0,0 +1,82 @@
+// MIT License
+//
+// Copyright (c) 2018 André Tupinambá
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "../../partial_sort/partial_sort.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <functional>
+
+namespace {
+
+simd_algorithms::aligned_vector< int32_t > random_vector( size_t size )
+{
+    simd_algorithms::aligned_vector< int32_t > ret;
+    srand( 1 );
+    std::generate_n( std::back_inserter( ret ), size, []{ return rand() % 100000; } );
+    return ret;
+}
+
+template< typename TAG_T >
+void check_partial_sort()
+{
+    namespace sa = simd_algorithms;
+    using container = sa::aligned_vector< int32_t >;
+
+    for( size_t size : { 5, 100, 1003, 100000 } )
+    {
+        container org = random_vector( size );
+        container sorted( org );
+        std::sort( sorted.begin(), sorted.end() );
+
+        for( size_t k : { 1, 7, 100 } )
+        {
+            size_t kk = std::min( k, size );
+            container top = sa::sort::top_k< container, TAG_T >( k ).select( org );
+            ASSERT_EQ( kk, top.size() );
+            EXPECT_TRUE( std::equal( top.begin(), top.end(), sorted.rbegin() ) );
+
+            container temp( org );
+            sa::sort::partial_sort< container, TAG_T >( k ).sort( temp );
+            EXPECT_TRUE( std::equal( temp.begin(), temp.begin() + kk, sorted.begin() ) );
+            std::sort( temp.begin(), temp.end() );
+            EXPECT_EQ( sorted, temp );
+        }
+
+        for( size_t n : { size_t(0), size / 3, size / 2, size - 1 } )
+        {
+            EXPECT_EQ( sorted[ n ], (sa::sort::nth_element< container, TAG_T >().select( org, n )) );
+        }
+    }
+}
+
+} // namespace
+
+TEST(PartialSortTest, SSE)
+{
+    check_partial_sort< simd_algorithms::sse_tag >();
+}
+
+TEST(PartialSortTest, AVX)
+{
+    check_partial_sort< simd_algorithms::avx_tag >();
+}
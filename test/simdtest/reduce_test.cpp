@@ -0,0 +1,118 @@
+// MIT License
+//
+// Copyright (c) 2018 André Tupinambá
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "../../reduce/reduce.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+namespace {
+
+namespace sa = simd_algorithms;
+
+template< typename TAG_T >
+void check_reduce( const sa::aligned_vector< int32_t >& in, size_t threads )
+{
+    namespace rd = sa::reduce;
+
+    int32_t lo = in.empty() ? std::numeric_limits< int32_t >::max() : *std::min_element( in.begin(), in.end() );
+    int32_t hi = in.empty() ? std::numeric_limits< int32_t >::min() : *std::max_element( in.begin(), in.end() );
+    EXPECT_EQ( lo, (rd::min< TAG_T >( in, threads )) ) << "size: " << in.size();
+    EXPECT_EQ( hi, (rd::max< TAG_T >( in, threads )) ) << "size: " << in.size();
+    EXPECT_EQ( std::make_pair( lo, hi ), (rd::minmax< TAG_T >( in, threads )) );
+    EXPECT_EQ( size_t( std::min_element( in.begin(), in.end() ) - in.begin() ), (rd::argmin< TAG_T >( in, threads )) )
+        << "size: " << in.size();
+    EXPECT_EQ( size_t( std::max_element( in.begin(), in.end() ) - in.begin() ), (rd::argmax< TAG_T >( in, threads )) )
+        << "size: " << in.size();
+    EXPECT_EQ( std::accumulate( in.begin(), in.end(), int64_t( 0 ) ), (rd::sum< TAG_T >( in, threads )) );
+
+    sa::aligned_vector< int32_t > incl( in.size() );
+    sa::aligned_vector< int32_t > excl( in.size() );
+    uint32_t acc = 0;
+    for( size_t i = 0; i < in.size(); ++i )
+    {
+        excl[i] = static_cast< int32_t >( acc );
+        acc += static_cast< uint32_t >( in[i] );
+        incl[i] = static_cast< int32_t >( acc );
+    }
+
+    sa::aligned_vector< int32_t > out;
+    EXPECT_EQ( static_cast< int32_t >( acc ), (rd::inclusive_scan< TAG_T >( in, out, threads )) );
+    EXPECT_EQ( incl, out ) << "size: " << in.size();
+    EXPECT_EQ( static_cast< int32_t >( acc ), (rd::exclusive_scan< TAG_T >( in, out, threads )) );
+    EXPECT_EQ( excl, out ) << "size: " << in.size();
+
+    // In place
+    out = in;
+    rd::exclusive_scan< TAG_T >( out, out, threads );
+    EXPECT_EQ( excl, out ) << "size: " << in.size();
+}
+
+template< typename TAG_T >
+void check_reduce_all()
+{
+    srand( 1 );
+    for( size_t size : { 0, 1, 3, 4, 8, 9, 17, 1000, 1003 } )
+    {
+        sa::aligned_vector< int32_t > in;
+        for( size_t i = 0; i < size; ++i )
+        {
+            in.push_back( rand() % 100 - 50 );
+        }
+        check_reduce< TAG_T >( in, 1 );
+
+        // Repeated extremes, the first one is the answer
+        if( size > 4 )
+        {
+            in[ size / 2 ] = in[ size - 1 ] = std::numeric_limits< int32_t >::max();
+            in[ 2 ] = in[ size - 2 ] = std::numeric_limits< int32_t >::min();
+            check_reduce< TAG_T >( in, 1 );
+        }
+    }
+
+    // Big values overflow 32 bits sums, several parts on several threads
+    sa::aligned_vector< int32_t > big;
+    for( size_t i = 0; i < 500000; ++i )
+    {
+        big.push_back( rand() - RAND_MAX / 2 + ((i % 3) ? 1000000000 : 0) );
+    }
+    big[ 300001 ] = std::numeric_limits< int32_t >::min();
+    big[ 400001 ] = std::numeric_limits< int32_t >::min();
+    for( size_t threads : { 1, 2, 3, 8 } )
+    {
+        check_reduce< TAG_T >( big, threads );
+    }
+}
+
+} // namespace
+
+TEST(ReduceTest, SSE)
+{
+    check_reduce_all< sa::sse_tag >();
+}
+
+TEST(ReduceTest, AVX)
+{
+    check_reduce_all< sa::avx_tag >();
+}
@@ -0,0 +1,95 @@
+// MIT License
+//
+// Copyright (c) 2018 André Tupinambá
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "../../replicated_index/replicated_index.h"
+#include "../../nway_tree/nway_tree.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+
+namespace {
+
+namespace sa = simd_algorithms;
+
+using container_type = sa::aligned_vector< int32_t >;
+
+template< typename TAG_T >
+void check_replicated_index()
+{
+    using index_type = sa::nway_tree::index< container_type, TAG_T >;
+
+    srand( 8 );
+    container_type sorted;
+    for( size_t i = 0; i < 10000; ++i )
+    {
+        sorted.push_back( rand() % 100000 );
+    }
+    std::sort( sorted.begin(), sorted.end() );
+    sorted.erase( std::unique( sorted.begin(), sorted.end() ), sorted.end() );
+
+    // Two nodes on the same CPUs, the host may have a single one
+    std::vector< int > cpus = sa::numa_topology().cpus( 0 );
+    sa::numa_topology topology( { cpus, cpus } );
+    sa::replicated_index< index_type > index( sorted, topology );
+    index.build_index();
+    ASSERT_EQ( 2u, index.replica_count() );
+    EXPECT_NE( index.on_node( 0 ).data.data(), index.on_node( 1 ).data.data() );
+    EXPECT_NE( sorted.data(), index.on_node( 0 ).data.data() );
+
+    for( int32_t key = -10; key < 100010; ++key )
+    {
+        auto first = std::lower_bound( sorted.begin(), sorted.end(), key );
+        size_t expected = (first != sorted.end() && *first == key) ? first - sorted.begin() : sorted.size();
+        ASSERT_EQ( expected, index.find( key ) ) << "key: " << key;
+    }
+    for( size_t node = 0; node < index.replica_count(); ++node )
+    {
+        auto& copy = index.on_node( node );
+        EXPECT_TRUE( copy.index.find( sorted[ 5 ] ) == copy.data.begin() + 5 );
+    }
+}
+
+} // namespace
+
+TEST(ReplicatedIndexTest, CpuList)
+{
+    EXPECT_EQ( std::vector< int >(), sa::numa_topology::parse_cpu_list( "" ) );
+    EXPECT_EQ( std::vector< int >( { 0 } ), sa::numa_topology::parse_cpu_list( "0" ) );
+    EXPECT_EQ( std::vector< int >( { 0, 1, 2, 3, 8, 10, 11 } ), sa::numa_topology::parse_cpu_list( "0-3,8,10-11" ) );
+
+    sa::numa_topology topology( { { 0, 1 }, { 2, 3 } } );
+    EXPECT_EQ( 2u, topology.node_count() );
+    EXPECT_EQ( 0u, topology.node_of_cpu( 1 ) );
+    EXPECT_EQ( 1u, topology.node_of_cpu( 2 ) );
+    EXPECT_EQ( 0u, topology.node_of_cpu( 100 ) );
+    EXPECT_GE( sa::numa_topology().node_count(), 1u );
+}
+
+TEST(ReplicatedIndexTest, SSE)
+{
+    check_replicated_index< sa::sse_tag >();
+}
+
+TEST(ReplicatedIndexTest, AVX)
+{
+    check_replicated_index< sa::avx_tag >();
+}
@@ -0,0 +1,135 @@
+// MIT License
+//
+// Copyright (c) 2018 André Tupinambá
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "../../set_algo/set_algo.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+
+namespace {
+
+namespace sa = simd_algorithms;
+
+// Sorted values without repeats, about one in every spread integers starting at first
+sa::aligned_vector< int32_t > make_set( size_t size, int32_t first, int32_t spread )
+{
+    sa::aligned_vector< int32_t > ret;
+    int32_t val = first;
+    for( size_t i = 0; i < size; ++i )
+    {
+        val += 1 + rand() % spread;
+        ret.push_back( val );
+    }
+    return ret;
+}
+
+template< typename TAG_T >
+void check_sets( const sa::aligned_vector< int32_t >& a, const sa::aligned_vector< int32_t >& b )
+{
+    sa::aligned_vector< int32_t > expected;
+    sa::aligned_vector< int32_t > found;
+
+    std::set_intersection( a.begin(), a.end(), b.begin(), b.end(), std::back_inserter( expected ) );
+    EXPECT_EQ( expected.size(), (sa::set_algo::set_intersection< TAG_T >( a, b, found )) );
+    EXPECT_EQ( expected, found ) << "intersection " << a.size() << " " << b.size();
+
+    expected.clear();
+    std::set_union( a.begin(), a.end(), b.begin(), b.end(), std::back_inserter( expected ) );
+    EXPECT_EQ( expected.size(), (sa::set_algo::set_union< TAG_T >( a, b, found )) );
+    EXPECT_EQ( expected, found ) << "union " << a.size() << " " << b.size();
+
+    expected.clear();
+    std::set_difference( a.begin(), a.end(), b.begin(), b.end(), std::back_inserter( expected ) );
+    EXPECT_EQ( expected.size(), (sa::set_algo::set_difference< TAG_T >( a, b, found )) );
+    EXPECT_EQ( expected, found ) << "difference " << a.size() << " " << b.size();
+}
+
+template< typename TAG_T >
+void check_set_algo()
+{
+    srand( 1 );
+    for( size_t na : { 0, 1, 7, 8, 9, 100, 1000, 5000 } )
+    {
+        for( size_t nb : { 0, 3, 8, 33, 1000, 4000 } )
+        {
+            for( int32_t spread : { 1, 3, 50 } )
+            {
+                check_sets< TAG_T >( make_set( na, -2000, spread ), make_set( nb, -2000, spread ) );
+            }
+        }
+    }
+
+    // Skewed sizes take the galloping path from both sides
+    sa::aligned_vector< int32_t > large = make_set( 100000, 0, 4 );
+    sa::aligned_vector< int32_t > small;
+    for( size_t i = 0; i < large.size(); i += 997 )
+    {
+        small.push_back( large[ i ] + (i % 2) );
+    }
+    check_sets< TAG_T >( small, large );
+    check_sets< TAG_T >( large, small );
+
+    // Extreme values
+    sa::aligned_vector< int32_t > ext = { std::numeric_limits< int32_t >::min(), -1, 0, 1, 2, 3, 4, 5, 6, 7,
+                                          std::numeric_limits< int32_t >::max() };
+    check_sets< TAG_T >( ext, make_set( 20, -10, 2 ) );
+    check_sets< TAG_T >( make_set( 20, -10, 2 ), ext );
+}
+
+template< typename TAG_T >
+void check_bitonic_merge()
+{
+    constexpr size_t array_size = sa::traits< int32_t, TAG_T >::simd_size;
+    for( int round = 0; round < 100; ++round )
+    {
+        sa::aligned_vector< int32_t > vals = make_set( 2 * array_size, -50, 10 );
+        std::random_shuffle( vals.begin(), vals.end() );
+        std::sort( vals.begin(), vals.begin() + array_size );
+        std::sort( vals.begin() + array_size, vals.end() );
+
+        auto lo = sa::loadu< int32_t, TAG_T >( vals.data() );
+        auto hi = sa::loadu< int32_t, TAG_T >( vals.data() + array_size );
+        sa::bitonic_merge< int32_t, TAG_T >( lo, hi );
+
+        sa::aligned_vector< int32_t > merged( 2 * array_size );
+        sa::storeu< int32_t, TAG_T >( merged.data(), lo );
+        sa::storeu< int32_t, TAG_T >( merged.data() + array_size, hi );
+        std::sort( vals.begin(), vals.end() );
+        EXPECT_EQ( vals, merged );
+    }
+}
+
+} // namespace
+
+TEST(SetAlgoTest, SSE)
+{
+    check_bitonic_merge< sa::sse_tag >();
+    check_set_algo< sa::sse_tag >();
+}
+
+TEST(SetAlgoTest, AVX)
+{
+    check_bitonic_merge< sa::avx_tag >();
+    check_set_algo< sa::avx_tag >();
+}
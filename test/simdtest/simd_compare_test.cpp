@@ -125,3 +125,23 @@ TEST(SimdCompareTest, LessThanAVX)
     EXPECT_EQ( 8u, (sa::greater_than_index< int32_t, sa::avx_tag >( 85, cmp )) );
 }
 
+
+TEST(SimdCompareTest, LessThanMask)
+{
+    namespace sa = simd_algorithms;
+    using simd32 = typename sa::traits< int32_t, sa::avx_tag >::simd_type;
+
+    simd32 cmp = _mm256_set_epi32( 80, 70, 60, 50, 40, 30, 20, 10 );
+    __m128i cmp128 = _mm_set_epi32( 40, 30, 20, 10 );
+
+    EXPECT_EQ( 0xffffu, sa::less_than_mask< int32_t >(  5, cmp128 ) );
+    EXPECT_EQ( 0xff00u, sa::less_than_mask< int32_t >( 20, cmp128 ) );
+    EXPECT_EQ( 0x0000u, sa::less_than_mask< int32_t >( 45, cmp128 ) );
+
+    EXPECT_EQ( 0xffffffffu, (sa::less_than_mask< int32_t, sa::avx_tag >(  5, cmp )) );
+    EXPECT_EQ( 0xfff00000u, (sa::less_than_mask< int32_t, sa::avx_tag >( 55, cmp )) );
+    EXPECT_EQ( 0x00000000u, (sa::less_than_mask< int32_t, sa::avx_tag >( 80, cmp )) );
+
+    EXPECT_EQ( 3u, (sa::mask_to_count< int32_t, sa::avx_tag >(
+                        sa::less_than_mask< int32_t, sa::avx_tag >( 55, cmp ) )) );
+}
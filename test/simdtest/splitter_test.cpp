@@ -0,0 +1,123 @@
+// MIT License
+//
+// Copyright (c) 2018 André Tupinambá
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "../../splitter/splitter.h"
+#include "gtest/gtest.h"
+
+#include <vector>
+
+namespace {
+
+std::string make_text( size_t size )
+{
+    std::string ret;
+    srand( 1 );
+    for( size_t i = 0; i < size; ++i )
+    {
+        ret.push_back( "ab,\"\n \t\r"[ rand() % 9 ] );
+    }
+    return ret;
+}
+
+std::vector< uint32_t > scalar_delimited( const std::string& text, char delimiter )
+{
+    std::vector< uint32_t > ret;
+    bool in_quote = false;
+    for( size_t i = 0; i < text.size(); ++i )
+    {
+        if( text[i] == '"' )
+            in_quote = !in_quote;
+        else if( !in_quote && (text[i] == delimiter || text[i] == '\n') )
+            ret.push_back( i );
+    }
+    return ret;
+}
+
+std::vector< uint32_t > scalar_whitespace( const std::string& text )
+{
+    std::vector< uint32_t > ret;
+    bool prev_space = true;
+    for( size_t i = 0; i < text.size(); ++i )
+    {
+        bool space = isspace( static_cast< unsigned char >( text[i] ) );
+        if( space != prev_space )
+            ret.push_back( i );
+        prev_space = space;
+    }
+    return ret;
+}
+
+// Splits text in chunks of chunk bytes with one splitter, offsets made absolute
+template< typename TAG_T >
+std::vector< uint32_t > split( simd_algorithms::string_algo::splitter< TAG_T > splitter,
+                               const std::string& text, size_t chunk )
+{
+    std::vector< uint32_t > ret;
+    std::vector< uint32_t > offsets( splitter.capacity( chunk ) );
+    for( size_t pos = 0; pos < text.size(); pos += chunk )
+    {
+        size_t len = std::min( chunk, text.size() - pos );
+        size_t count = splitter( text.data() + pos, len, offsets.data() );
+        for( size_t i = 0; i < count; ++i )
+        {
+            ret.push_back( pos + offsets[i] );
+        }
+    }
+    return ret;
+}
+
+template< typename TAG_T >
+void check_splitter()
+{
+    using splitter = simd_algorithms::string_algo::splitter< TAG_T >;
+
+    std::string text = make_text( 3000 );
+    for( size_t chunk : { 1, 7, 64, 100, 3000 } )
+    {
+        EXPECT_EQ( scalar_delimited( text, ',' ), split( splitter(), text, chunk ) ) << "chunk: " << chunk;
+        EXPECT_EQ( scalar_delimited( text, '\t' ), split( splitter( '\t' ), text, chunk ) ) << "chunk: " << chunk;
+        EXPECT_EQ( scalar_whitespace( text ), split( splitter::whitespace(), text, chunk ) ) << "chunk: " << chunk;
+    }
+
+    splitter csv;
+    std::vector< uint32_t > offsets( csv.capacity( 16 ) );
+    EXPECT_EQ( 3, csv( "a,\"b,\nc\",d\n\"open", offsets.data() ) );
+    EXPECT_EQ( 1, offsets[0] );
+    EXPECT_EQ( 8, offsets[1] );
+    EXPECT_EQ( 10, offsets[2] );
+    EXPECT_TRUE( csv.in_quote() );
+    csv.reset();
+    EXPECT_FALSE( csv.in_quote() );
+    EXPECT_EQ( 0, csv( "", offsets.data() ) );
+}
+
+} // namespace
+
+TEST(SplitterTest, SSE)
+{
+    check_splitter< simd_algorithms::sse_tag >();
+}
+
+TEST(SplitterTest, AVX)
+{
+    check_splitter< simd_algorithms::avx_tag >();
+}
@@ -0,0 +1,133 @@
+// MIT License
+//
+// Copyright (c) 2018 André Tupinambá
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "../../stream_transform/stream_transform.h"
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+namespace {
+
+simd_algorithms::aligned_string random_text( size_t size )
+{
+    simd_algorithms::aligned_string ret( size, ' ' );
+    srand( 1 );
+    for( auto&& ch : ret )
+    {
+        ch = static_cast< char >( rand() );
+    }
+    return ret;
+}
+
+simd_algorithms::aligned_string scalar_lower( simd_algorithms::aligned_string str )
+{
+    for( auto&& ch : str )
+    {
+        ch = ('A' <= ch && ch <= 'Z') ? ch + 0x20 : ch;
+    }
+    return str;
+}
+
+simd_algorithms::aligned_string read_file( const std::string& name, size_t size )
+{
+    simd_algorithms::aligned_string ret( size + 1, ' ' );
+    FILE* in = fopen( name.c_str(), "rb" );
+    ret.resize( fread( (char*) ret.data(), 1, ret.size(), in ) );
+    fclose( in );
+    return ret;
+}
+
+// Keeps the pool busy, so chunks are still queued when the stream fails
+template< typename TAG_T >
+struct slow_lower
+{
+    void run( const char* src, char* dst, size_t size, bool non_temporal = false ) const
+    {
+        std::this_thread::sleep_for( std::chrono::milliseconds( 5 ) );
+        simd_algorithms::string_algo::to_lower< TAG_T >().run( src, dst, size, non_temporal );
+    }
+};
+
+template< typename TAG_T >
+void check_stream_transform()
+{
+    namespace sa = simd_algorithms;
+    using stream_type = sa::string_algo::stream_transform< sa::string_algo::to_lower< TAG_T > >;
+
+    // Chunks of 4KB with a partial one at the end
+    constexpr size_t size = 0x00041003;
+    sa::aligned_string text = random_text( size );
+    sa::aligned_string expected = scalar_lower( text );
+
+    std::string input = testing::TempDir() + "stream_transform_in.txt";
+    std::string output = testing::TempDir() + "stream_transform_out.txt";
+    FILE* in = fopen( input.c_str(), "wb" );
+    ASSERT_NE( nullptr, in );
+    fwrite( text.data(), 1, text.size(), in );
+    fclose( in );
+
+    stream_type( 3, 0x1000 )( input, output );
+    EXPECT_EQ( expected, read_file( output, size ) );
+
+    int in_fd = open( input.c_str(), O_RDONLY );
+    int out_fd = open( output.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644 );
+    ASSERT_LE( 0, in_fd );
+    ASSERT_LE( 0, out_fd );
+    stream_type( 3, 0x1000 )( in_fd, out_fd );
+    close( in_fd );
+    close( out_fd );
+    EXPECT_EQ( expected, read_file( output, size ) );
+
+    // Non-temporal stores give the same bytes
+    sa::aligned_string nt( size, ' ' );
+    sa::string_algo::to_lower< TAG_T >().run( text.data() + 1, (char*) nt.data() + 1, size - 1, true );
+    EXPECT_EQ( expected.substr( 1 ), nt.substr( 1 ) );
+
+    EXPECT_THROW( stream_type()( input + ".missing", output ), std::system_error );
+
+    // A write error while chunks are still queued in the pool, the output is read only
+    in_fd = open( input.c_str(), O_RDONLY );
+    out_fd = open( input.c_str(), O_RDONLY );
+    ASSERT_LE( 0, in_fd );
+    ASSERT_LE( 0, out_fd );
+    using slow_type = sa::string_algo::stream_transform< slow_lower< TAG_T > >;
+    EXPECT_THROW( slow_type( 2, 0x1000 )( in_fd, out_fd ), std::system_error );
+    close( in_fd );
+    close( out_fd );
+
+    remove( input.c_str() );
+    remove( output.c_str() );
+}
+
+} // namespace
+
+TEST(StreamTransformTest, SSE)
+{
+    check_stream_transform< simd_algorithms::sse_tag >();
+}
+
+TEST(StreamTransformTest, AVX)
+{
+    check_stream_transform< simd_algorithms::avx_tag >();
+}
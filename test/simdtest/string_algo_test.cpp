@@ -0,0 +1,285 @@
+// MIT License
+//
+// Copyright (c) 2018 André Tupinambá
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "../../to_lower/to_lower.h"
+#include "../../utf8/utf8.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+
+namespace {
+
+simd_algorithms::aligned_string all_bytes( size_t size )
+{
+    simd_algorithms::aligned_string ret;
+    for( size_t i = 0; i < size; ++i )
+    {
+        ret.push_back( static_cast< char >( (i * 7) & 0xff ) );
+    }
+    return ret;
+}
+
+template< typename Transform_T, typename Scalar_T >
+void check_transform( Transform_T transform, Scalar_T scalar )
+{
+    for( size_t size : { 0, 1, 15, 16, 33, 1000 } )
+    {
+        simd_algorithms::aligned_string str = all_bytes( size );
+        simd_algorithms::aligned_string expected( str );
+        for( auto&& ch : expected )
+        {
+            ch = scalar( ch );
+        }
+        transform( str );
+        EXPECT_EQ( expected, str ) << "size: " << size;
+    }
+}
+
+template< typename TAG_T >
+void check_string_algo()
+{
+    namespace sa = simd_algorithms;
+
+    check_transform( sa::string_algo::to_lower< TAG_T >(),
+                     []( char ch ){ return ('A' <= ch && ch <= 'Z') ? ch + 0x20 : ch; } );
+    check_transform( sa::string_algo::to_upper< TAG_T >(),
+                     []( char ch ){ return ('a' <= ch && ch <= 'z') ? ch - 0x20 : ch; } );
+
+    // Rules see the original byte, so a swap is possible
+    using swap_ab = sa::string_algo::transform< TAG_T,
+                                                sa::string_algo::byte_rule< 'a', 'b' >,
+                                                sa::string_algo::byte_rule< 'b', 'a' >,
+                                                sa::string_algo::range_rule< 0xc0, 0xff, 1 > >;
+    check_transform( swap_ab(),
+                     []( char ch ){ unsigned char uch = ch;
+                                    return (ch == 'a') ? 'b' : (ch == 'b') ? 'a'
+                                         : (uch >= 0xc0) ? static_cast< char >( uch + 1 ) : ch; } );
+
+    sa::string_algo::table_transform< TAG_T > tr( "abc\xff", "xyz\x01" );
+    check_transform( tr,
+                     []( char ch ){ return (ch == 'a') ? 'x' : (ch == 'b') ? 'y' : (ch == 'c') ? 'z'
+                                         : (ch == '\xff') ? '\x01' : ch; } );
+}
+
+template< typename TAG_T >
+void check_unaligned()
+{
+    namespace sa = simd_algorithms;
+    using lower = sa::string_algo::to_lower< TAG_T >;
+    using swap_ab = sa::string_algo::transform< TAG_T,
+                                                sa::string_algo::byte_rule< 'a', 'b' >,
+                                                sa::string_algo::byte_rule< 'b', 'a' > >;
+
+    std::string org;
+    for( size_t i = 0; i < 200; ++i )
+    {
+        org += "aBcDeFgHiJkLmNoPqRsTuVwXyZ-0123"[ (i * 5) % 31 ];
+    }
+    std::string lowered( org );
+    std::string swapped( org );
+    for( size_t i = 0; i < org.size(); ++i )
+    {
+        lowered[i] = ('A' <= org[i] && org[i] <= 'Z') ? org[i] + 0x20 : org[i];
+        swapped[i] = (org[i] == 'a') ? 'b' : (org[i] == 'b') ? 'a' : org[i];
+    }
+
+    for( size_t off : { 0, 1, 7, 31 } )
+    {
+        for( size_t size : { 0, 3, 32, 33, 100, 150 } )
+        {
+            boost::string_view view( org.data() + off, size );
+            std::string out( size + 5, '#' );
+            char* end = lower()( view, &out[ 5 - off % 5 ] );
+            EXPECT_EQ( &out[ 5 - off % 5 ] + size, end );
+            EXPECT_EQ( lowered.substr( off, size ), out.substr( 5 - off % 5, size ) )
+                << "off: " << off << ", size: " << size;
+
+            // In place: non idempotent rules must not be applied twice on the tail
+            std::string temp( org );
+            swap_ab()( &temp[ off ], &temp[ off ] + size );
+            EXPECT_EQ( org.substr( 0, off ) + swapped.substr( off, size ) + org.substr( off + size ),
+                       temp ) << "off: " << off << ", size: " << size;
+        }
+    }
+}
+
+template< typename TAG_T >
+void check_utf8_to_lower()
+{
+    namespace sa = simd_algorithms;
+    using lower = sa::string_algo::utf8_to_lower< TAG_T >;
+
+    // Random mix of ASCII, every two byte code point and a few three byte ones
+    srand( 1 );
+    for( size_t size : { 1, 17, 64, 1000, 10000 } )
+    {
+        for( size_t ratio : { 2, 3, 8, 64 } )
+        {
+            // Odd ratios only use letters of the vector path
+            static const uint32_t vector_letters[] = { 0xc9, 0xe9, 0x3a3, 0x3a0, 0x3c3, 0x416,
+                                                       0x42f, 0x401, 0x436, 0x451 };
+            sa::aligned_string str;
+            sa::aligned_string expected;
+            while( str.size() < size )
+            {
+                uint32_t cp = ((rand() % ratio) == 0) ? 0x80 + rand() % 0x780 : rand() % 0x80;
+                if( (ratio & 1) && cp >= 0x80 )
+                    cp = vector_letters[ rand() % 10 ];
+
+                if( (rand() % 100) == 0 )
+                {
+                    str += "\xe2\x82\xac";
+                    expected += "\xe2\x82\xac";
+                }
+                else if( cp < 0x80 )
+                {
+                    str += static_cast< char >( cp );
+                    expected += static_cast< char >( ('A' <= cp && cp <= 'Z') ? cp + 0x20 : cp );
+                }
+                else
+                {
+                    uint32_t lcp = lower::lower( cp );
+                    str += static_cast< char >( 0xc0 | (cp >> 6) );
+                    str += static_cast< char >( 0x80 | (cp & 0x3f) );
+                    expected += static_cast< char >( 0xc0 | (lcp >> 6) );
+                    expected += static_cast< char >( 0x80 | (lcp & 0x3f) );
+                }
+            }
+
+            lower()( str );
+            EXPECT_EQ( expected, str ) << "size: " << size << ", ratio: " << ratio;
+        }
+    }
+
+    sa::aligned_string str( "\xc3\x89T\xc3\x89 \xce\xa3\xce\x9f\xce\x8c \xd0\x81\xd0\x96\xd0\xaf \xc4\x80 \xc3\x97" );
+    lower()( str );
+    EXPECT_EQ( "\xc3\xa9t\xc3\xa9 \xcf\x83\xce\xbf\xcf\x8c \xd1\x91\xd0\xb6\xd1\x8f \xc4\x81 \xc3\x97", str );
+}
+
+// Byte at a time reference for the validator
+bool scalar_valid_utf8( const std::string& str )
+{
+    const unsigned char* s = (const unsigned char*) str.data();
+    for( size_t i = 0; i < str.size(); )
+    {
+        unsigned char lead = s[i];
+        size_t len = (lead < 0x80) ? 1 : (lead >= 0xc2 && lead <= 0xdf) ? 2
+                   : (lead >= 0xe0 && lead <= 0xef) ? 3 : (lead >= 0xf0 && lead <= 0xf4) ? 4 : 0;
+        if( len == 0 || i + len > str.size() )
+            return false;
+        for( size_t j = 1; j < len; ++j )
+        {
+            if( (s[i + j] & 0xc0) != 0x80 )
+                return false;
+        }
+        if( (lead == 0xe0 && s[i + 1] < 0xa0) || (lead == 0xed && s[i + 1] > 0x9f)
+            || (lead == 0xf0 && s[i + 1] < 0x90) || (lead == 0xf4 && s[i + 1] > 0x8f) )
+            return false;
+        i += len;
+    }
+    return true;
+}
+
+template< typename TAG_T >
+void check_utf8_validation()
+{
+    namespace sa = simd_algorithms;
+    static const char* sequences[] = { "a", "Z", "\xc3\xa9", "\xce\xa3", "\xe2\x82\xac", "\xed\x9f\xbf",
+                                       "\xef\xbf\xbf", "\xf0\x90\x80\x80", "\xf4\x8f\xbf\xbf" };
+
+    // Valid text with one random byte changed, at every size around the register edges
+    srand( 1 );
+    for( size_t size = 0; size < 200; ++size )
+    {
+        for( size_t round = 0; round < 20; ++round )
+        {
+            std::string str;
+            while( str.size() < size )
+            {
+                str += sequences[ (round < 2) ? rand() % 2 : rand() % 9 ];
+            }
+            if( round > 0 && !str.empty() )
+                str[ rand() % str.size() ] = static_cast< char >( rand() );
+
+            EXPECT_EQ( scalar_valid_utf8( str ), sa::string_algo::is_valid_utf8< TAG_T >( str ) )
+                << "size: " << size << ", round: " << round;
+            bool ascii = std::all_of( str.begin(), str.end(), []( char ch ){ return ch >= 0; } );
+            EXPECT_EQ( ascii, sa::string_algo::is_ascii< TAG_T >( str ) );
+        }
+    }
+
+    for( const char* invalid : { "\xc0\x80", "\xc1\xbf", "\xe0\x9f\xbf", "\xed\xa0\x80", "\xf0\x8f\xbf\xbf",
+                                 "\xf4\x90\x80\x80", "\xf5\x80\x80\x80", "\xff", "\x80", "\xc3", "\xe2\x82" } )
+    {
+        // At the start, across a register boundary and at the end
+        for( size_t pad : { 0, 14, 31, 60, 64 } )
+        {
+            sa::aligned_string str( pad, 'x' );
+            str += invalid;
+            EXPECT_FALSE( sa::string_algo::is_valid_utf8< TAG_T >( str ) ) << "pad: " << pad;
+            str += sa::aligned_string( 70, 'y' );
+            EXPECT_FALSE( sa::string_algo::is_valid_utf8< TAG_T >( str ) ) << "pad: " << pad;
+        }
+    }
+}
+
+} // namespace
+
+TEST(StringAlgoTest, TransformSSE)
+{
+    check_string_algo< simd_algorithms::sse_tag >();
+}
+
+TEST(StringAlgoTest, TransformAVX)
+{
+    check_string_algo< simd_algorithms::avx_tag >();
+}
+
+TEST(StringAlgoTest, UnalignedSSE)
+{
+    check_unaligned< simd_algorithms::sse_tag >();
+}
+
+TEST(StringAlgoTest, UnalignedAVX)
+{
+    check_unaligned< simd_algorithms::avx_tag >();
+}
+
+TEST(StringAlgoTest, Utf8ToLowerSSE)
+{
+    check_utf8_to_lower< simd_algorithms::sse_tag >();
+}
+
+TEST(StringAlgoTest, Utf8ToLowerAVX)
+{
+    check_utf8_to_lower< simd_algorithms::avx_tag >();
+}
+
+TEST(StringAlgoTest, Utf8ValidationSSE)
+{
+    check_utf8_validation< simd_algorithms::sse_tag >();
+}
+
+TEST(StringAlgoTest, Utf8ValidationAVX)
+{
+    check_utf8_validation< simd_algorithms::avx_tag >();
+}
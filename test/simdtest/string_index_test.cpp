@@ -0,0 +1,134 @@
+// MIT License
+//
+// Copyright (c) 2018 André Tupinambá
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "../../nway_tree/string_index.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <array>
+
+namespace {
+
+namespace sa = simd_algorithms;
+
+template< size_t Size_T >
+using key_type = std::array< char, Size_T >;
+
+template< size_t Size_T >
+key_type< Size_T > make_key( const std::string& str )
+{
+    key_type< Size_T > key;
+    key.fill( 0 );
+    std::copy_n( str.begin(), std::min( str.size(), Size_T ), key.begin() );
+    return key;
+}
+
+// Short codes over a small alphabet, so many keys share their prefix
+template< size_t Size_T >
+std::string random_code()
+{
+    static const char letters[] = "ABC\x7f\x80\xff";
+    std::string str;
+    size_t len = 1 + rand() % Size_T;
+    for( size_t i = 0; i < len; ++i )
+    {
+        str.push_back( letters[ rand() % 6 ] );
+    }
+    return str;
+}
+
+template< size_t Size_T >
+bool memcmp_less( const key_type< Size_T >& lhs, const key_type< Size_T >& rhs )
+{
+    return std::memcmp( lhs.data(), rhs.data(), Size_T ) < 0;
+}
+
+template< size_t Size_T, typename TAG_T, typename Prefix_T >
+void check_string_index( size_t count )
+{
+    using container_type = sa::aligned_vector< key_type< Size_T > >;
+
+    srand( 6 );
+    container_type sorted;
+    for( size_t i = 0; i < count; ++i )
+    {
+        sorted.push_back( make_key< Size_T >( random_code< Size_T >() ) );
+    }
+    std::sort( sorted.begin(), sorted.end(), memcmp_less< Size_T > );
+
+    sa::nway_tree::string_index< container_type, TAG_T, Prefix_T > index( sorted );
+    index.build_index();
+
+    for( size_t i = 0; i < 3 * count + 10; ++i )
+    {
+        auto key = make_key< Size_T >( random_code< Size_T >() );
+        auto first = std::lower_bound( sorted.begin(), sorted.end(), key, memcmp_less< Size_T > );
+        ASSERT_EQ( first - sorted.begin(), index.lower_bound( key ) - sorted.begin() );
+        bool found = first != sorted.end() && *first == key;
+        ASSERT_EQ( found ? first - sorted.begin() : sorted.end() - sorted.begin(),
+                   index.find( key ) - sorted.begin() );
+    }
+}
+
+template< typename TAG_T >
+void check_string_indexes()
+{
+    for( size_t count : { 0, 1, 5, 100, 3000 } )
+    {
+        check_string_index< 3, TAG_T, int32_t >( count );
+        check_string_index< 8, TAG_T, int64_t >( count );
+        check_string_index< 16, TAG_T, int32_t >( count );
+        check_string_index< 16, TAG_T, int64_t >( count );
+        check_string_index< 40, TAG_T, int64_t >( count );
+    }
+}
+
+} // namespace
+
+TEST(StringIndexTest, CompareBytes)
+{
+    char lhs[ 70 ];
+    char rhs[ 70 ];
+    for( size_t len = 0; len <= sizeof( lhs ); ++len )
+    {
+        for( size_t diff = 0; diff < len; ++diff )
+        {
+            std::fill_n( lhs, len, 'a' );
+            std::fill_n( rhs, len, 'a' );
+            rhs[ diff ] = '\xf0';
+            EXPECT_LT( (sa::compare_bytes< sa::sse_tag >( lhs, rhs, len )), 0 );
+            EXPECT_GT( (sa::compare_bytes< sa::avx_tag >( rhs, lhs, len )), 0 );
+        }
+        EXPECT_EQ( 0, (sa::compare_bytes< sa::sse_tag >( lhs, lhs, len )) );
+        EXPECT_EQ( 0, (sa::compare_bytes< sa::avx_tag >( lhs, lhs, len )) );
+    }
+}
+
+TEST(StringIndexTest, SSE)
+{
+    check_string_indexes< sa::sse_tag >();
+}
+
+TEST(StringIndexTest, AVX)
+{
+    check_string_indexes< sa::avx_tag >();
+}
@@ -0,0 +1,121 @@
+// MIT License
+//
+// Copyright (c) 2018 André Tupinambá
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "../../string_search/string_search.h"
+#include "gtest/gtest.h"
+
+#include <iterator>
+
+namespace {
+
+std::string make_text( size_t size )
+{
+    std::string ret;
+    srand( 1 );
+    for( size_t i = 0; i < size; ++i )
+    {
+        ret.push_back( "abcab\n"[ rand() % 6 ] );
+    }
+    return ret;
+}
+
+template< typename TAG_T >
+void check_string_search()
+{
+    namespace sa = simd_algorithms;
+    using result_type = typename sa::string_algo::multi_searcher< TAG_T >::result_type;
+
+    std::string text = make_text( 1000 );
+    for( std::string needle : { "a", "ab", "abc", "cab\na", "bbbb", "abcabcab", "abcabcabcabcabcabcabcabcabcabcabc" } )
+    {
+        std::vector< size_t > expected;
+        for( size_t pos = text.find( needle ); pos != std::string::npos; pos = text.find( needle, pos + 1 ) )
+        {
+            expected.push_back( pos );
+        }
+
+        std::vector< size_t > found;
+        sa::string_algo::find_all< TAG_T >( text, needle, std::back_inserter( found ) );
+        EXPECT_EQ( expected, found ) << "needle: " << needle;
+
+        for( size_t pos : { 0, 1, 17, 500, 990, 1000, 1001 } )
+        {
+            EXPECT_EQ( text.find( needle, pos ), sa::string_algo::find< TAG_T >( text, needle, pos ) )
+                << "needle: " << needle << " pos: " << pos;
+        }
+    }
+    EXPECT_EQ( 3, sa::string_algo::find< TAG_T >( text, "", 3 ) );
+    EXPECT_EQ( std::string::npos, sa::string_algo::find< TAG_T >( "abc", "abcd" ) );
+
+    std::vector< std::string > keywords = { "cab", "ab", "bca\n", "c", "zz" };
+    std::vector< result_type > expected;
+    for( size_t pos = 0; pos < text.size(); ++pos )
+    {
+        for( size_t k = 0; k < keywords.size(); ++k )
+        {
+            if( text.compare( pos, keywords[k].size(), keywords[k] ) == 0 )
+                expected.push_back( result_type( pos, k ) );
+        }
+    }
+
+    sa::string_algo::multi_searcher< TAG_T > multi( keywords );
+    std::vector< result_type > found;
+    multi.find_all( text, std::back_inserter( found ) );
+    EXPECT_EQ( expected, found );
+    EXPECT_EQ( expected.front(), multi.find( text ) );
+    EXPECT_EQ( result_type( std::string::npos, std::string::npos ),
+               multi.find( text, text.size() ) );
+
+    // More keywords than kept candidate masks
+    std::vector< std::string > many;
+    for( size_t k = 0; k < 20; ++k )
+    {
+        many.push_back( text.substr( k * 40, 2 + k % 5 ) );
+    }
+    sa::string_algo::multi_searcher< TAG_T > multi_many( many );
+    found.clear();
+    multi_many.find_all( text, std::back_inserter( found ) );
+    expected.clear();
+    for( size_t pos = 0; pos < text.size(); ++pos )
+    {
+        for( size_t k = 0; k < many.size(); ++k )
+        {
+            if( text.compare( pos, many[k].size(), many[k] ) == 0 )
+                expected.push_back( result_type( pos, k ) );
+        }
+    }
+    EXPECT_EQ( expected, found );
+
+    EXPECT_THROW( sa::string_algo::multi_searcher< TAG_T >( { "a", "" } ), std::invalid_argument );
+}
+
+} // namespace
+
+TEST(StringSearchTest, SSE)
+{
+    check_string_search< simd_algorithms::sse_tag >();
+}
+
+TEST(StringSearchTest, AVX)
+{
+    check_string_search< simd_algorithms::avx_tag >();
+}
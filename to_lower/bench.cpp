@@ -68,6 +68,28 @@ struct autovec_to_lower
     }
 };
 
+template< typename TAG_T >
+struct tr_lower : sa::string_algo::table_transform< TAG_T >
+{
+    tr_lower()
+        : sa::string_algo::table_transform< TAG_T >( "ABCDEFGHIJKLMNOPQRSTUVWXYZ",
+                                                     "abcdefghijklmnopqrstuvwxyz" ){}
+};
+
+// Zero copy from an unaligned substring to an unaligned buffer
+template< typename TAG_T >
+struct view_to_lower
+{
+    void operator()( sa::aligned_string& str )
+    {
+        out_.resize( str.size() + 3 );
+        sa::string_algo::to_lower< TAG_T >()( boost::string_view( str.data() + 1, str.size() - 1 ),
+                                              (char*) out_.data() + 3 );
+    }
+
+    sa::aligned_string out_;
+};
+
 void do_nothing( const sa::aligned_string& );
 
 template< typename TO_LOWER_T >
@@ -118,6 +140,11 @@ int main(int argc, char* /*argv*/[])
         {
             bench< std_to_lower >( "STD ...", runSize, loop );
             bench< autovec_to_lower >( "Autovec", runSize, loop );
+            bench< sa::string_algo::to_upper< sa::avx_tag > >( "AVX to_upper", runSize, loop );
+            bench< view_to_lower< sa::sse_tag > >( "SSE view ...", runSize, loop );
+            bench< view_to_lower< sa::avx_tag > >( "AVX view ...", runSize, loop );
+            bench< tr_lower< sa::sse_tag > >( "SSE table ..", runSize, loop );
+            bench< tr_lower< sa::avx_tag > >( "AVX table ..", runSize, loop );
             std::cout
                       << std::endl << "Index Speed up SSE.......: " << std::fixed << std::setprecision(2)
                       << static_cast<float>(base)/static_cast<float>(sse) << "x"
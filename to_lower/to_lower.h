@@ -25,42 +25,286 @@
 
 #include <iostream>
 #include <iomanip>
+#include <array>
+#include <string>
+#include <vector>
+#include <boost/utility/string_view.hpp>
 #include "../simd_compare.h"
 
 namespace simd_algorithms{
 namespace string_algo{
 
+// Runs simd_op over [src, src + size) writing to dst, which is either src or does not overlap
+// it. A scalar head aligns dst, the main loop stores aligned registers and the tail is one
+// last register ending at size where the lanes already done keep what is in dst.
+// With NonTemporal_T the main loop stores bypass the cache.
+template< typename TAG_T, bool NonTemporal_T = false, typename SimdOp_T, typename CharOp_T >
+inline void transform_range( const char* src, char* dst, size_t size,
+                             SimdOp_T simd_op, CharOp_T char_op )
+{
+    constexpr static size_t array_size = traits< char, TAG_T >::simd_size;
+    using simd_type = typename traits< char, TAG_T >::simd_type;
+
+    if( size < array_size )
+    {
+        for( size_t i = 0; i < size; ++i )
+        {
+            dst[i] = char_op( src[i] );
+        }
+        return;
+    }
+
+    size_t head = (0 - reinterpret_cast< uintptr_t >( dst )) & (array_size - 1);
+    for( size_t i = 0; i < head; ++i )
+    {
+        dst[i] = char_op( src[i] );
+    }
+
+    size_t i = head;
+    for( ; i + array_size <= size; i += array_size )
+    {
+        if( NonTemporal_T )
+            store_nt< char, TAG_T >( dst + i, simd_op( loadu< char, TAG_T >( src + i ) ) );
+        else
+            *reinterpret_cast< simd_type* >( dst + i ) = simd_op( loadu< char, TAG_T >( src + i ) );
+    }
+
+    if( NonTemporal_T )
+        _mm_sfence();
+
+    if( i < size )
+    {
+        size_t last = size - array_size;
+        storeu< char, TAG_T >( dst + last,
+                               iif< TAG_T >( head_mask< char, TAG_T >( i - last ),
+                                             loadu< char, TAG_T >( dst + last ),
+                                             simd_op( loadu< char, TAG_T >( src + last ) ) ) );
+    }
+}
+
+// In place, out of place, unaligned and string_view entry points for a transform that
+// provides run( src, dst, size, non_temporal )
+template< typename Impl_T >
+struct transform_overloads
+{
+    void operator()( aligned_string& str ) const
+    {
+        impl().run( str.data(), (char*) str.data(), str.size() );
+    }
+
+    void operator()( char* first, char* last ) const
+    {
+        impl().run( first, first, last - first );
+    }
+
+    char* operator()( const char* first, const char* last, char* out ) const
+    {
+        impl().run( first, out, last - first );
+        return out + (last - first);
+    }
+
+    char* operator()( boost::string_view str, char* out ) const
+    {
+        impl().run( str.data(), out, str.size() );
+        return out + str.size();
+    }
+
+private:
+    const Impl_T& impl() const
+    {
+        return static_cast< const Impl_T& >( *this );
+    }
+};
+
+// Bytes in [Lo_T, Hi_T] (unsigned) get Delta_T added
+template< unsigned char Lo_T, unsigned char Hi_T, char Delta_T >
+struct range_rule
+{
+    static_assert( Lo_T <= Hi_T, "empty range" );
+
+    template< typename TAG_T >
+    static typename traits< char, TAG_T >::simd_type
+    match( typename traits< char, TAG_T >::simd_type data )
+    {
+        return in_range< char, TAG_T >( data, Lo_T, Hi_T );
+    }
+
+    static bool match( char ch )
+    {
+        unsigned char uch = ch;
+        return Lo_T <= uch && uch <= Hi_T;
+    }
+
+    constexpr static char delta = Delta_T;
+};
+
+// Single byte replacement, tr From_T To_T
+template< unsigned char From_T, unsigned char To_T >
+using byte_rule = range_rule< From_T, From_T, static_cast< char >( To_T - From_T ) >;
+
+// Every rule is matched against the original byte, the first match wins
+template< typename TAG_T, typename... Rules_T >
+struct apply_rules
+{
+    using simd_type = typename traits< char, TAG_T >::simd_type;
+
+    static simd_type apply( simd_type, simd_type data )
+    {
+        return data;
+    }
+
+    static char apply( char, char ch )
+    {
+        return ch;
+    }
+};
+
+template< typename TAG_T, typename Rule_T, typename... Rules_T >
+struct apply_rules< TAG_T, Rule_T, Rules_T... >
+{
+    using simd_type = typename traits< char, TAG_T >::simd_type;
+
+    static simd_type apply( simd_type org, simd_type data )
+    {
+        data = apply_rules< TAG_T, Rules_T... >::apply( org, data );
+        return iif< TAG_T >( Rule_T::template match< TAG_T >( org ),
+                             add< char, TAG_T >( org, Rule_T::delta ),
+                             data );
+    }
+
+    static char apply( char org, char ch )
+    {
+        return Rule_T::match( org )
+            ? static_cast< char >( org + Rule_T::delta )
+            : apply_rules< TAG_T, Rules_T... >::apply( org, ch );
+    }
+};
+
+// Byte transform from a compile time rule set, branch free over whole registers
+template< typename TAG_T, typename... Rules_T >
+struct transform : transform_overloads< transform< TAG_T, Rules_T... > >
+{
+    using simd_type = typename traits< char, TAG_T >::simd_type;
+
+    static simd_type apply( simd_type data )
+    {
+        return apply_rules< TAG_T, Rules_T... >::apply( data, data );
+    }
+
+    static char apply( char ch )
+    {
+        return apply_rules< TAG_T, Rules_T... >::apply( ch, ch );
+    }
+
+    void run( const char* src, char* dst, size_t size, bool non_temporal = false ) const
+    {
+        auto simd_op = []( simd_type data ){ return apply( data ); };
+        auto char_op = []( char ch ){ return apply( ch ); };
+        if( non_temporal )
+            transform_range< TAG_T, true >( src, dst, size, simd_op, char_op );
+        else
+            transform_range< TAG_T >( src, dst, size, simd_op, char_op );
+    }
+};
+
 template< typename TAG_T >
-struct to_lower
+using to_lower = transform< TAG_T, range_rule< 'A', 'Z', 0x20 > >;
+
+template< typename TAG_T >
+using to_upper = transform< TAG_T, range_rule< 'a', 'z', -0x20 > >;
+
+// Unicode simple case folding restricted to ASCII is the same as lowercasing
+template< typename TAG_T >
+using case_fold = to_lower< TAG_T >;
+
+// Arbitrary byte to byte map. The 256 entry table is split in 16 rows of 16 bytes and each
+// row is a pshufb lookup by the low nibble. Rows that map every byte to itself are skipped.
+template< typename TAG_T >
+class table_transform : public transform_overloads< table_transform< TAG_T > >
 {
-    void operator()( aligned_string& str )
+public:
+    using simd_type = typename traits< char, TAG_T >::simd_type;
+    using table_type = std::array< char, 256 >;
+
+    table_transform( const table_type& table )
+        : table_( table )
     {
-        constexpr static size_t array_size = traits< char, TAG_T >::simd_size;
-        using simd_type = typename traits< char, TAG_T >::simd_type;
+        find_rows();
+    }
 
-        simd_type* data = (simd_type*) str.data();
+    // tr style map, from[i] becomes to[i]
+    table_transform( const std::string& from, const std::string& to )
+    {
+        for( size_t i = 0; i < table_.size(); ++i )
+        {
+            table_[i] = static_cast< char >( i );
+        }
+        for( size_t i = 0; i < from.size() && i < to.size(); ++i )
+        {
+            table_[ static_cast< unsigned char >( from[i] ) ] = to[i];
+        }
+        find_rows();
+    }
 
-        size_t sz = str.size() & ~(array_size-1);
-        for( size_t i = 0; i < sz; i += array_size )
+    char apply( char ch ) const
+    {
+        return table_[ static_cast< unsigned char >( ch ) ];
+    }
+
+    void run( const char* src, char* dst, size_t size, bool non_temporal = false ) const
+    {
+        simd_type rows[ 16 ];
+        for( size_t i = 0; i < rows_.size(); ++i )
         {
-            *data = iif< TAG_T >( mask_and< TAG_T >( greater_than< char, TAG_T >( *data, 'A'-1 ),
-                                                     greater_than< char, TAG_T >( 'Z'+1, *data ) ),
-                                  add< char, TAG_T >( *data, 0x20 ),
-                                  *data );
-            ++data;
+            rows[i] = lookup_table< TAG_T >( &table_[ rows_[i] * 16 ] );
         }
 
-        size_t end = str.size();
-        for( size_t i = sz; i < end; ++i )
+        auto simd_op = [this, &rows]( simd_type data ){ return apply( rows, data ); };
+        auto char_op = [this]( char ch ){ return apply( ch ); };
+        if( non_temporal )
+            transform_range< TAG_T, true >( src, dst, size, simd_op, char_op );
+        else
+            transform_range< TAG_T >( src, dst, size, simd_op, char_op );
+    }
+
+private:
+    table_type table_;
+    std::vector< size_t > rows_;
+
+    void find_rows()
+    {
+        for( size_t row = 0; row < 16; ++row )
         {
-            str[i] = ( 'A' <= str[i] && str[i] <= 'Z' ) ? str[i] + 0x20 : str[i];
+            for( size_t i = row * 16; i < (row + 1) * 16; ++i )
+            {
+                if( table_[i] != static_cast< char >( i ) )
+                {
+                    rows_.push_back( row );
+                    break;
+                }
+            }
         }
+    }
 
+    // Row r is looked up with data ^ (r << 4) saturated by 0x70: the index keeps its low
+    // nibble when the high nibble matches and gets bit 7 set otherwise.
+    simd_type apply( const simd_type (&rows)[ 16 ], simd_type data ) const
+    {
+        simd_type ret = data;
+        for( size_t i = 0; i < rows_.size(); ++i )
+        {
+            simd_type index = saturated_add< char, TAG_T >(
+                                mask_xor< TAG_T >( data,
+                                    broadcast< char, TAG_T >( static_cast< char >( rows_[i] << 4 ) ) ),
+                                0x70 );
+            ret = iif< TAG_T >( greater_than< char, TAG_T >( index, -1 ),
+                                lookup< TAG_T >( rows[i], index ),
+                                ret );
+        }
+        return ret;
     }
 };
 
-
 }} // namespace simd_algorithms::string_algo
 
 #endif // SIMD_ALGORITHMS_TO_LOWER_H
-
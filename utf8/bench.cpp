@@ -0,0 +1,205 @@
+// MIT License
+//
+// Copyright (c) 2018 André Tupinambá
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "utf8.h"
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <numeric>
+#include <boost/timer/timer.hpp>
+
+bool g_verbose = true;
+namespace sa = simd_algorithms;
+
+struct scalar_utf8_to_lower
+{
+    void operator()( sa::aligned_string& str )
+    {
+        using lower = sa::string_algo::utf8_to_lower< sa::sse_tag >;
+        size_t sz = str.size();
+        char* s = (char*) str.data();
+        for( size_t i = 0; i < sz; ++i )
+        {
+            unsigned char lead = s[i];
+            if( 'A' <= lead && lead <= 'Z' )
+            {
+                s[i] = lead + 0x20;
+            }
+            else if( 0xc0 <= lead && lead <= 0xdf && i + 1 < sz )
+            {
+                uint32_t cp = lower::lower( ((lead & 0x1f) << 6) | (s[i+1] & 0x3f) );
+                s[i] = static_cast< char >( 0xc0 | (cp >> 6) );
+                s[++i] = static_cast< char >( 0x80 | (cp & 0x3f) );
+            }
+        }
+    }
+};
+
+void do_nothing( const sa::aligned_string& );
+void do_nothing( bool );
+
+// Byte at a time validation, same rules as utf8_validator
+struct scalar_validate_utf8
+{
+    void operator()( sa::aligned_string& str )
+    {
+        const unsigned char* s = (const unsigned char*) str.data();
+        size_t sz = str.size();
+        bool valid = true;
+        for( size_t i = 0; valid && i < sz; )
+        {
+            unsigned char lead = s[i];
+            size_t len = (lead < 0x80) ? 1 : (lead >= 0xc2 && lead <= 0xdf) ? 2
+                       : (lead >= 0xe0 && lead <= 0xef) ? 3 : (lead >= 0xf0 && lead <= 0xf4) ? 4 : 0;
+            valid = len != 0 && i + len <= sz;
+            for( size_t j = 1; valid && j < len; ++j )
+            {
+                valid = (s[i + j] & 0xc0) == 0x80;
+            }
+            if( valid && len == 3 )
+            {
+                valid = !(lead == 0xe0 && s[i + 1] < 0xa0) && !(lead == 0xed && s[i + 1] > 0x9f);
+            }
+            if( valid && len == 4 )
+            {
+                valid = !(lead == 0xf0 && s[i + 1] < 0x90) && !(lead == 0xf4 && s[i + 1] > 0x8f);
+            }
+            i += len;
+        }
+        do_nothing( valid );
+    }
+};
+
+template< typename TAG_T >
+struct validate_utf8
+{
+    void operator()( sa::aligned_string& str )
+    {
+        do_nothing( sa::string_algo::is_valid_utf8< TAG_T >( str ) );
+    }
+};
+
+template< typename TAG_T >
+struct is_ascii
+{
+    void operator()( sa::aligned_string& str )
+    {
+        do_nothing( sa::string_algo::is_ascii< TAG_T >( str ) );
+    }
+};
+
+// Mostly ASCII text with one two byte letter every ratio bytes (0 for pure ASCII)
+sa::aligned_string make_text( size_t size, size_t ratio )
+{
+    static const char* letters[] = { "\xc3\x89", "\xce\xa3", "\xd0\x96", "\xc4\x80" };
+    sa::aligned_string str;
+    size_t cnt = 0;
+    while( str.size() < size )
+    {
+        if( ratio != 0 && (cnt % ratio) == 0 )
+            str += letters[ (cnt / ratio) % 4 ];
+        else
+            str += 'C';
+        ++cnt;
+    }
+    return str;
+}
+
+template< typename TO_LOWER_T >
+uint64_t bench( const std::string& name, size_t size, size_t loop, size_t ratio )
+{
+	using functor = TO_LOWER_T;
+
+    boost::timer::cpu_timer timer;
+    functor toLower;
+
+    sa::aligned_string str = make_text( size, ratio );
+
+    timer.start();
+    for( size_t j = 0; j < loop; ++j )
+    {
+        toLower( str );
+        do_nothing( str );
+    }
+    timer.stop();
+    if( g_verbose )
+        std::cout << "To lower " << name << ": " << timer.format();
+
+    return timer.elapsed().wall;
+}
+
+int main(int argc, char* /*argv*/[])
+{
+    constexpr size_t runSize = 0x00100001;
+    constexpr size_t loop = 1000;
+    constexpr size_t ratio = 200;
+    if( argc > 1 )
+    {
+        g_verbose = false;
+        std::cout << "count,ascii sse,ascii avx,utf8 base,utf8 sse,utf8 avx" << std::endl;
+    }
+    else
+    {
+        std::cout << "\nsize: 0x" << std::hex << std::setw(8) << std::setfill( '0') << runSize << std::endl << std::endl;
+    }
+    size_t cnt = 0;
+    while( 1 )
+    {
+        uint64_t asse = bench< sa::string_algo::to_lower< sa::sse_tag > >( "ASCII SSE .........", runSize, loop, 0 );
+        uint64_t aavx = bench< sa::string_algo::to_lower< sa::avx_tag > >( "ASCII AVX .........", runSize, loop, 0 );
+        uint64_t base = bench< scalar_utf8_to_lower >( "UTF-8 Scalar ......", runSize, loop, ratio );
+        uint64_t sse = bench< sa::string_algo::utf8_to_lower< sa::sse_tag > >( "UTF-8 SSE .........", runSize, loop, ratio );
+        uint64_t avx = bench< sa::string_algo::utf8_to_lower< sa::avx_tag > >( "UTF-8 AVX .........", runSize, loop, ratio );
+
+        if( g_verbose )
+        {
+            bench< sa::string_algo::utf8_to_lower< sa::sse_tag > >( "UTF-8 SSE on ASCII ", runSize, loop, 0 );
+            bench< sa::string_algo::utf8_to_lower< sa::avx_tag > >( "UTF-8 AVX on ASCII ", runSize, loop, 0 );
+            bench< is_ascii< sa::avx_tag > >( "Is ASCII AVX ......", runSize, loop, 0 );
+            bench< scalar_validate_utf8 >( "Validate Scalar ...", runSize, loop, ratio );
+            bench< validate_utf8< sa::sse_tag > >( "Validate SSE ......", runSize, loop, ratio );
+            bench< validate_utf8< sa::avx_tag > >( "Validate AVX ......", runSize, loop, ratio );
+            bench< validate_utf8< sa::avx_tag > >( "Validate AVX ASCII ", runSize, loop, 0 );
+            std::cout
+                      << std::endl << "UTF-8 Speed up SSE.......: " << std::fixed << std::setprecision(2)
+                      << static_cast<float>(base)/static_cast<float>(sse) << "x"
+
+                      << std::endl << "UTF-8 Speed up AVX.......: " << std::fixed << std::setprecision(2)
+                      << static_cast<float>(base)/static_cast<float>(avx) << "x"
+
+                      << std::endl << std::endl;
+        }
+        else
+        {
+            std::cout
+                << ++cnt << ","
+                << asse << ","
+                << aavx << ","
+                << base << ","
+                << sse << ","
+                << avx
+                << std::endl;
+        }
+    }
+    return 0;
+}
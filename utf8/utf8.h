@@ -0,0 +1,418 @@
+// MIT License
+//
+// Copyright (c) 2018 André Tupinambá
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef SIMD_ALGORITHMS_UTF8_H
+#define SIMD_ALGORITHMS_UTF8_H
+
+#include <array>
+#include <cstring>
+#include <boost/utility/string_view.hpp>
+#include "../simd_compare.h"
+#include "../to_lower/to_lower.h"
+
+namespace simd_algorithms{
+namespace string_algo{
+
+// UTF-8 lowercase for the scripts whose lowercase has the same encoded length: ASCII,
+// Latin-1, Latin Extended-A, Greek, Cyrillic and Armenian. Other sequences are kept.
+//
+// Pure ASCII registers take the to_lower path. Registers whose multibyte sequences are
+// Latin-1 (C3), Greek capitals (CE 91-AB) or basic Cyrillic (D0) are lowercased with vector
+// rules on the byte before (for continuation bytes) and the byte after (for lead bytes).
+// Anything else goes through the scalar code, which decodes from the original bytes and
+// only writes inside the register, so both paths agree on sequences across registers.
+template< typename TAG_T >
+struct utf8_to_lower
+{
+    using simd_type = typename traits< char, TAG_T >::simd_type;
+
+    void operator()( aligned_string& str )
+    {
+        constexpr static size_t array_size = traits< char, TAG_T >::simd_size;
+
+        size_t size = str.size();
+        char* ptr = (char*) str.data();
+        simd_type* data = (simd_type*) ptr;
+        simd_type prev = traits< char, TAG_T >::zero();
+        char prev_last = 0;
+
+        // The byte after the register must exist
+        size_t i = 0;
+        while( i + array_size < size )
+        {
+            // Four pure ASCII registers at once
+            if( i + 4 * array_size < size &&
+                result_to_mask< char, TAG_T >( mask_or< TAG_T >( mask_or< TAG_T >( data[0], data[1] ),
+                                                                 mask_or< TAG_T >( data[2], data[3] ) ) ) == 0 )
+            {
+                prev = data[3];
+                prev_last = ptr[ i + 4 * array_size - 1 ];
+                for( size_t j = 0; j < 4; ++j )
+                {
+                    data[j] = to_lower< TAG_T >::apply( data[j] );
+                }
+                i += 4 * array_size;
+                data += 4;
+                continue;
+            }
+
+            simd_type cur = *data;
+            char last = ptr[ i + array_size - 1 ];
+            if( result_to_mask< char, TAG_T >( cur ) == 0 )
+            {
+                *data = to_lower< TAG_T >::apply( cur );
+            }
+            else
+            {
+                simd_type before = prev_bytes< 1, TAG_T >( cur, prev );
+                simd_type after = loadu< char, TAG_T >( ptr + i + 1 );
+                if( result_to_mask< char, TAG_T >( scalar_mask( before, cur, after ) ) == 0 )
+                {
+                    *data = apply( before, cur, after );
+                }
+                else
+                {
+                    lower_scalar( prev_last, ptr + i, array_size, ptr[ i + array_size ] );
+                }
+            }
+            prev = cur;
+            prev_last = last;
+            i += array_size;
+            ++data;
+        }
+
+        if( i < size )
+        {
+            lower_scalar( prev_last, ptr + i, size - i, 0 );
+        }
+    }
+
+    // Simple lowercase mapping of the two byte code points
+    static uint32_t lower( uint32_t cp )
+    {
+        if( 0x00c0 <= cp && cp <= 0x00de )
+            return (cp == 0x00d7) ? cp : cp + 0x20;
+
+        if( 0x0100 <= cp && cp <= 0x017f )
+        {
+            if( cp == 0x0130 || cp == 0x0131 || cp == 0x0138 || cp == 0x0149 || cp == 0x017f )
+                return cp;
+            if( cp == 0x0178 )
+                return 0x00ff;
+            if( (0x0139 <= cp && cp <= 0x0148) || (0x0179 <= cp && cp <= 0x017e) )
+                return (cp & 1) ? cp + 1 : cp;
+            return (cp & 1) ? cp : cp + 1;
+        }
+
+        if( 0x0386 <= cp && cp <= 0x03ab )
+        {
+            if( cp == 0x0386 )
+                return 0x03ac;
+            if( 0x0388 <= cp && cp <= 0x038a )
+                return cp + 0x25;
+            if( cp == 0x038c )
+                return 0x03cc;
+            if( cp == 0x038e || cp == 0x038f )
+                return cp + 0x3f;
+            if( 0x0391 <= cp && cp != 0x03a2 )
+                return cp + 0x20;
+            return cp;
+        }
+
+        if( 0x0400 <= cp && cp <= 0x052f )
+        {
+            if( cp <= 0x040f )
+                return cp + 0x50;
+            if( cp <= 0x042f )
+                return cp + 0x20;
+            if( cp == 0x04c0 )
+                return 0x04cf;
+            if( 0x04c1 <= cp && cp <= 0x04ce )
+                return (cp & 1) ? cp + 1 : cp;
+            if( (0x0460 <= cp && cp <= 0x0481) || 0x048a <= cp )
+                return (cp & 1) ? cp : cp + 1;
+            return cp;
+        }
+
+        if( 0x0531 <= cp && cp <= 0x0556 )
+            return cp + 0x30;
+
+        return cp;
+    }
+
+private:
+    // Lead bytes and lead/continuation pairs only handled by the scalar code
+    static simd_type scalar_mask( simd_type before, simd_type cur, simd_type after )
+    {
+        return mask_or< TAG_T >( mask_or< TAG_T >( scalar_lead( before ), scalar_lead( cur ) ),
+                                 mask_or< TAG_T >( scalar_pair( before, cur ),
+                                                   scalar_pair( cur, after ) ) );
+    }
+
+    static simd_type scalar_lead( simd_type lead )
+    {
+        return mask_or< TAG_T >( in_range< char, TAG_T >( lead, '\xc4', '\xc5' ),
+                                 in_range< char, TAG_T >( lead, '\xd2', '\xd5' ) );
+    }
+
+    static simd_type scalar_pair( simd_type lead, simd_type cont )
+    {
+        return mask_or< TAG_T >(
+                mask_and< TAG_T >( equal< char, TAG_T >( lead, '\xce' ),
+                                   in_range< char, TAG_T >( cont, '\x80', '\x90' ) ),
+                mask_and< TAG_T >( equal< char, TAG_T >( lead, '\xd1' ),
+                                   in_range< char, TAG_T >( cont, '\xa0', '\xbf' ) ) );
+    }
+
+    static simd_type apply( simd_type before, simd_type cur, simd_type after )
+    {
+        simd_type c3 = equal< char, TAG_T >( before, '\xc3' );
+        simd_type ce = equal< char, TAG_T >( before, '\xce' );
+        simd_type d0 = equal< char, TAG_T >( before, '\xd0' );
+
+        // Continuation bytes
+        simd_type plus20 = mask_or< TAG_T >(
+            mask_and< TAG_T >( c3, mask_or< TAG_T >( in_range< char, TAG_T >( cur, '\x80', '\x96' ),
+                                                     in_range< char, TAG_T >( cur, '\x98', '\x9e' ) ) ),
+            mask_or< TAG_T >( mask_and< TAG_T >( ce, in_range< char, TAG_T >( cur, '\x91', '\x9f' ) ),
+                              mask_and< TAG_T >( d0, in_range< char, TAG_T >( cur, '\x90', '\x9f' ) ) ) );
+        simd_type minus20 = mask_or< TAG_T >(
+            mask_and< TAG_T >( ce, greek_high( cur ) ),
+            mask_and< TAG_T >( d0, in_range< char, TAG_T >( cur, '\xa0', '\xaf' ) ) );
+        simd_type plus10 = mask_and< TAG_T >( d0, in_range< char, TAG_T >( cur, '\x80', '\x8f' ) );
+
+        // Lead bytes: CE -> CF and D0 -> D1
+        simd_type plus1 = mask_or< TAG_T >(
+            mask_and< TAG_T >( equal< char, TAG_T >( cur, '\xce' ), greek_high( after ) ),
+            mask_and< TAG_T >( equal< char, TAG_T >( cur, '\xd0' ),
+                               mask_or< TAG_T >( in_range< char, TAG_T >( after, '\x80', '\x8f' ),
+                                                 in_range< char, TAG_T >( after, '\xa0', '\xaf' ) ) ) );
+
+        simd_type ret = to_lower< TAG_T >::apply( cur );
+        ret = iif< TAG_T >( plus20, add< char, TAG_T >( cur, 0x20 ), ret );
+        ret = iif< TAG_T >( minus20, add< char, TAG_T >( cur, -0x20 ), ret );
+        ret = iif< TAG_T >( plus10, add< char, TAG_T >( cur, 0x10 ), ret );
+        return iif< TAG_T >( plus1, add< char, TAG_T >( cur, 1 ), ret );
+    }
+
+    // Greek capitals U+03A0-U+03AB (but the unassigned U+03A2) continuation bytes
+    static simd_type greek_high( simd_type cont )
+    {
+        return mask_or< TAG_T >( in_range< char, TAG_T >( cont, '\xa0', '\xa1' ),
+                                 in_range< char, TAG_T >( cont, '\xa3', '\xab' ) );
+    }
+
+    // Lowercases ptr[0, len), len up to one register, decoding from the original bytes.
+    // before is the byte preceding ptr and after the one following ptr[len-1], 0 when missing.
+    static void lower_scalar( char before, char* ptr, size_t len, char after )
+    {
+        constexpr static size_t array_size = traits< char, TAG_T >::simd_size;
+        std::array< unsigned char, array_size + 2 > buf;
+        buf[0] = before;
+        std::copy( ptr, ptr + len, buf.begin() + 1 );
+        buf[ len + 1 ] = after;
+
+        for( size_t j = 0; j <= len; ++j )
+        {
+            unsigned char lead = buf[j];
+            if( 1 <= j && 'A' <= lead && lead <= 'Z' )
+            {
+                ptr[ j - 1 ] = lead + 0x20;
+            }
+            else if( 0xc0 <= lead && lead <= 0xdf && (buf[ j + 1 ] & 0xc0) == 0x80 )
+            {
+                uint32_t cp = ((lead & 0x1f) << 6) | (buf[ j + 1 ] & 0x3f);
+                uint32_t lcp = lower( cp );
+                if( lcp != cp )
+                {
+                    if( 1 <= j )
+                        ptr[ j - 1 ] = static_cast< char >( 0xc0 | (lcp >> 6) );
+                    if( j < len )
+                        ptr[ j ] = static_cast< char >( 0x80 | (lcp & 0x3f) );
+                }
+            }
+        }
+    }
+};
+
+// True when every byte is below 0x80. The registers are or-ed four at a time and the last
+// one overlaps the previous so there is no scalar tail.
+template< typename TAG_T >
+inline bool is_ascii( boost::string_view str )
+{
+    constexpr static size_t array_size = traits< char, TAG_T >::simd_size;
+    using simd_type = typename traits< char, TAG_T >::simd_type;
+
+    const char* ptr = str.data();
+    size_t size = str.size();
+    if( size < array_size )
+    {
+        char acc = 0;
+        for( size_t i = 0; i < size; ++i )
+        {
+            acc |= ptr[i];
+        }
+        return acc >= 0;
+    }
+
+    simd_type acc = traits< char, TAG_T >::zero();
+    size_t i = 0;
+    for( ; i + 4 * array_size <= size; i += 4 * array_size )
+    {
+        acc = mask_or< TAG_T >( acc, mask_or< TAG_T >(
+                    mask_or< TAG_T >( loadu< char, TAG_T >( ptr + i ),
+                                      loadu< char, TAG_T >( ptr + i + array_size ) ),
+                    mask_or< TAG_T >( loadu< char, TAG_T >( ptr + i + 2 * array_size ),
+                                      loadu< char, TAG_T >( ptr + i + 3 * array_size ) ) ) );
+    }
+    for( ; i + array_size <= size; i += array_size )
+    {
+        acc = mask_or< TAG_T >( acc, loadu< char, TAG_T >( ptr + i ) );
+    }
+    acc = mask_or< TAG_T >( acc, loadu< char, TAG_T >( ptr + size - array_size ) );
+    return result_to_mask< char, TAG_T >( acc ) == 0;
+}
+
+// UTF-8 validation with nibble lookups (Keiser and Lemire). Each byte is checked with the one
+// before it: three tables, indexed by the high and low nibbles of the previous byte and the
+// high nibble of the current one, give a bit per kind of error and the three are and-ed.
+// Three and four byte sequences also need the byte two or three positions back to be a
+// lead, which is xor-ed with the continuation bit from the tables. Runs of ASCII registers
+// are skipped. The tail is zero padded, so a sequence cut at the end is an error.
+template< typename TAG_T >
+struct utf8_validator
+{
+    using simd_type = typename traits< char, TAG_T >::simd_type;
+    constexpr static size_t array_size = traits< char, TAG_T >::simd_size;
+
+    bool operator()( boost::string_view str ) const
+    {
+        const char* ptr = str.data();
+        size_t size = str.size();
+        simd_type error = traits< char, TAG_T >::zero();
+        simd_type prev = traits< char, TAG_T >::zero();
+        bool prev_ascii = true;
+
+        size_t i = 0;
+        while( i + array_size <= size )
+        {
+            if( prev_ascii && i + 4 * array_size <= size )
+            {
+                simd_type last = loadu< char, TAG_T >( ptr + i + 3 * array_size );
+                simd_type any = mask_or< TAG_T >(
+                        mask_or< TAG_T >( loadu< char, TAG_T >( ptr + i ),
+                                          loadu< char, TAG_T >( ptr + i + array_size ) ),
+                        mask_or< TAG_T >( loadu< char, TAG_T >( ptr + i + 2 * array_size ), last ) );
+                if( result_to_mask< char, TAG_T >( any ) == 0 )
+                {
+                    prev = last;
+                    i += 4 * array_size;
+                    continue;
+                }
+            }
+
+            simd_type cur = loadu< char, TAG_T >( ptr + i );
+            bool ascii = result_to_mask< char, TAG_T >( cur ) == 0;
+            if( !ascii || !prev_ascii )
+                error = mask_or< TAG_T >( error, check( cur, prev ) );
+            prev = cur;
+            prev_ascii = ascii;
+            i += array_size;
+        }
+
+        char tail[ array_size ] = {};
+        std::memcpy( tail, ptr + i, size - i );
+        error = mask_or< TAG_T >( error, check( loadu< char, TAG_T >( tail ), prev ) );
+        return all_zero< TAG_T >( error );
+    }
+
+    // Non zero bytes where cur, with the bytes of prev before it, is not valid
+    static simd_type check( simd_type cur, simd_type prev )
+    {
+        constexpr char too_short = 1 << 0;  // 11______ 0_______ or 11______ 11______
+        constexpr char too_long = 1 << 1;   // 0_______ 10______
+        constexpr char overlong_3 = 1 << 2; // 11100000 100_____
+        constexpr char too_large = 1 << 3;  // 11110100 1001____ and above
+        constexpr char surrogate = 1 << 4;  // 11101101 101_____
+        constexpr char overlong_2 = 1 << 5; // 1100000_ 10______
+        constexpr char too_large_1000 = 1 << 6; // 11110101 1000____ and above
+        constexpr char overlong_4 = 1 << 6; // 11110000 1000____
+        constexpr char two_conts = static_cast< char >( 1 << 7 ); // 10______ 10______
+        constexpr char carry = too_short | too_long | two_conts;
+
+        alignas( 16 ) static const char byte_1_high[16] = {
+            too_long, too_long, too_long, too_long, too_long, too_long, too_long, too_long,
+            two_conts, two_conts, two_conts, two_conts,
+            too_short | overlong_2,
+            too_short,
+            too_short | overlong_3 | surrogate,
+            too_short | too_large | too_large_1000 | overlong_4 };
+        alignas( 16 ) static const char byte_1_low[16] = {
+            carry | overlong_3 | overlong_2 | overlong_4,
+            carry | overlong_2,
+            carry,
+            carry,
+            carry | too_large,
+            carry | too_large | too_large_1000,
+            carry | too_large | too_large_1000,
+            carry | too_large | too_large_1000,
+            carry | too_large | too_large_1000,
+            carry | too_large | too_large_1000,
+            carry | too_large | too_large_1000,
+            carry | too_large | too_large_1000,
+            carry | too_large | too_large_1000,
+            carry | too_large | too_large_1000 | surrogate,
+            carry | too_large | too_large_1000,
+            carry | too_large | too_large_1000 };
+        alignas( 16 ) static const char byte_2_high[16] = {
+            too_short, too_short, too_short, too_short, too_short, too_short, too_short, too_short,
+            too_long | overlong_2 | two_conts | overlong_3 | too_large_1000 | overlong_4,
+            too_long | overlong_2 | two_conts | overlong_3 | too_large,
+            too_long | overlong_2 | two_conts | surrogate | too_large,
+            too_long | overlong_2 | two_conts | surrogate | too_large,
+            too_short, too_short, too_short, too_short };
+
+        simd_type prev1 = prev_bytes< 1, TAG_T >( cur, prev );
+        simd_type special = mask_and< TAG_T >(
+                mask_and< TAG_T >( lookup< TAG_T >( lookup_table< TAG_T >( byte_1_high ), high_nibble< TAG_T >( prev1 ) ),
+                                   lookup< TAG_T >( lookup_table< TAG_T >( byte_1_low ), low_nibble< TAG_T >( prev1 ) ) ),
+                lookup< TAG_T >( lookup_table< TAG_T >( byte_2_high ), high_nibble< TAG_T >( cur ) ) );
+
+        // Bit 7 set after a three (111_____) or four (1111____) byte lead
+        simd_type must_be_continuation = mask_and< TAG_T >(
+                mask_or< TAG_T >( saturated_sub< char, TAG_T >( prev_bytes< 2, TAG_T >( cur, prev ), 0xe0 - 0x80 ),
+                                  saturated_sub< char, TAG_T >( prev_bytes< 3, TAG_T >( cur, prev ), 0xf0 - 0x80 ) ),
+                broadcast< char, TAG_T >( static_cast< char >( 0x80 ) ) );
+
+        return mask_xor< TAG_T >( must_be_continuation, special );
+    }
+};
+
+template< typename TAG_T >
+inline bool is_valid_utf8( boost::string_view str )
+{
+    return utf8_validator< TAG_T >()( str );
+}
+
+}} // namespace simd_algorithms::string_algo
+
+#endif // SIMD_ALGORITHMS_UTF8_H